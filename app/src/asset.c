@@ -0,0 +1,353 @@
+#include "asset.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/pm/device.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * The assets partition starts with a table:
+ * - header: "HWVA", version (u16), number of assets (u16)
+ * - entries: name (24 bytes, NUL padded), offset (u32), size (u32)
+ *
+ * Offsets are relative to the partition. Each asset starts with its width,
+ * height, number of frames and frame period in ms (u16 each), followed by
+ * its frames. A frame is a sequence of opcodes covering all lines:
+ * - 0x00-0x7f: the next (op + 1) lines did not change
+ * - 0x80-0xff: the next (op - 0x7f) lines changed, each coded with PackBits
+ *
+ * All values are little endian.
+ */
+#define ASSET_MAGIC   "HWVA"
+#define ASSET_VERSION 1U
+
+#define ASSET_OP_CHANGED BIT(7)
+
+#define ASSET_PARTITION FIXED_PARTITION_ID(assets_partition)
+
+struct asset_table_hdr {
+	uint8_t magic[4];
+	uint16_t version;
+	uint16_t count;
+} __packed;
+
+struct asset_entry {
+	char name[ASSET_NAME_LEN];
+	uint32_t offset;
+	uint32_t size;
+} __packed;
+
+struct asset_hdr {
+	uint16_t width;
+	uint16_t height;
+	uint16_t frames;
+	uint16_t period_ms;
+} __packed;
+
+static int asset_power(const struct flash_area *fa, bool on)
+{
+	int ret;
+
+	ret = pm_device_action_run(fa->fa_dev,
+				   on ? PM_DEVICE_ACTION_RESUME : PM_DEVICE_ACTION_SUSPEND);
+	if (ret == -EALREADY) {
+		return 0;
+	}
+
+	return ret;
+}
+
+static int asset_find(const struct flash_area *fa, size_t idx, const char *name,
+		      struct asset_entry *entry)
+{
+	struct asset_table_hdr hdr;
+	int ret;
+
+	ret = flash_area_read(fa, 0, &hdr, sizeof(hdr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (memcmp(hdr.magic, ASSET_MAGIC, sizeof(hdr.magic)) != 0 ||
+	    sys_le16_to_cpu(hdr.version) != ASSET_VERSION) {
+		return -ENOENT;
+	}
+
+	for (size_t i = 0U; i < sys_le16_to_cpu(hdr.count); i++) {
+		if (name == NULL && i != idx) {
+			continue;
+		}
+
+		ret = flash_area_read(fa, sizeof(hdr) + i * sizeof(*entry), entry, sizeof(*entry));
+		if (ret < 0) {
+			return ret;
+		}
+
+		entry->name[ASSET_NAME_LEN - 1U] = '\0';
+
+		if (name == NULL || strcmp(entry->name, name) == 0) {
+			entry->offset = sys_le32_to_cpu(entry->offset);
+			entry->size = sys_le32_to_cpu(entry->size);
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+int asset_get_name(size_t idx, char *name)
+{
+	const struct flash_area *fa;
+	struct asset_entry entry;
+	int ret;
+
+	ret = flash_area_open(ASSET_PARTITION, &fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = asset_power(fa, true);
+	if (ret == 0) {
+		ret = asset_find(fa, idx, NULL, &entry);
+		(void)asset_power(fa, false);
+	}
+
+	flash_area_close(fa);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(name, entry.name, ASSET_NAME_LEN);
+
+	return 0;
+}
+
+int asset_open(struct asset *a, const char *name)
+{
+	struct asset_entry entry;
+	struct asset_hdr hdr;
+	int ret;
+
+	ret = flash_area_open(ASSET_PARTITION, &a->fa);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = asset_power(a->fa, true);
+	if (ret < 0) {
+		flash_area_close(a->fa);
+		return ret;
+	}
+
+	ret = asset_find(a->fa, 0U, name, &entry);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	if (entry.size < sizeof(hdr) || entry.offset > a->fa->fa_size ||
+	    entry.size > a->fa->fa_size - entry.offset) {
+		ret = -EINVAL;
+		goto fail;
+	}
+
+	ret = flash_area_read(a->fa, entry.offset, &hdr, sizeof(hdr));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	a->info.width = sys_le16_to_cpu(hdr.width);
+	a->info.height = sys_le16_to_cpu(hdr.height);
+	a->info.frames = sys_le16_to_cpu(hdr.frames);
+	a->info.period_ms = sys_le16_to_cpu(hdr.period_ms);
+
+	a->start = entry.offset + sizeof(hdr);
+	a->end = entry.offset + entry.size;
+	a->bytes_read = sizeof(hdr);
+
+	asset_rewind(a);
+
+	return 0;
+
+fail:
+	(void)asset_power(a->fa, false);
+	flash_area_close(a->fa);
+
+	return ret;
+}
+
+void asset_close(struct asset *a)
+{
+	(void)asset_power(a->fa, false);
+	flash_area_close(a->fa);
+}
+
+void asset_rewind(struct asset *a)
+{
+	a->frame = 0U;
+	a->pos = a->start;
+	a->head = 0U;
+	a->tail = 0U;
+}
+
+/* make at least one byte available in the read buffer */
+static int asset_fill(struct asset *a)
+{
+	size_t len;
+	int ret;
+
+	if (a->head < a->tail) {
+		return 0;
+	}
+
+	len = MIN(sizeof(a->buf), a->end - a->pos);
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	ret = flash_area_read(a->fa, a->pos, a->buf, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	a->pos += len;
+	a->bytes_read += len;
+	a->head = 0U;
+	a->tail = len;
+
+	return 0;
+}
+
+static int asset_byte(struct asset *a, uint8_t *byte)
+{
+	int ret;
+
+	ret = asset_fill(a);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*byte = a->buf[a->head++];
+
+	return 0;
+}
+
+/* decode one PackBits coded line */
+static int asset_line(struct asset *a, uint8_t *line, size_t len)
+{
+	size_t done = 0U;
+	int ret;
+
+	while (done < len) {
+		uint8_t ctrl;
+		size_t n;
+
+		ret = asset_byte(a, &ctrl);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ctrl == 128U) {
+			continue;
+		}
+
+		n = (ctrl < 128U) ? ctrl + 1U : 257U - ctrl;
+		if (n > len - done) {
+			return -EINVAL;
+		}
+
+		if (ctrl > 128U) {
+			uint8_t val;
+
+			ret = asset_byte(a, &val);
+			if (ret < 0) {
+				return ret;
+			}
+
+			memset(&line[done], val, n);
+			done += n;
+			continue;
+		}
+
+		/* literal bytes may span several buffer fills */
+		while (n > 0U) {
+			size_t chunk;
+
+			ret = asset_fill(a);
+			if (ret < 0) {
+				return ret;
+			}
+
+			chunk = MIN(n, a->tail - a->head);
+			memcpy(&line[done], &a->buf[a->head], chunk);
+			a->head += chunk;
+			done += chunk;
+			n -= chunk;
+		}
+	}
+
+	return 0;
+}
+
+int asset_decode(struct asset *a, asset_line_t line, void *user_data, uint16_t *first,
+		 uint16_t *last)
+{
+	size_t len = DIV_ROUND_UP(a->info.width, 8U);
+	uint16_t y = 0U;
+	int ret;
+
+	if (a->frame >= a->info.frames) {
+		return -ENODATA;
+	}
+
+	if (a->frame == 0U) {
+		for (uint16_t i = 0U; i < a->info.height; i++) {
+			memset(line(i, user_data), 0xff, len);
+		}
+	}
+
+	*first = a->info.height;
+	*last = 0U;
+
+	while (y < a->info.height) {
+		uint8_t op;
+		uint16_t n;
+
+		ret = asset_byte(a, &op);
+		if (ret < 0) {
+			return ret;
+		}
+
+		n = (op & ~ASSET_OP_CHANGED) + 1U;
+		if (n > a->info.height - y) {
+			return -EINVAL;
+		}
+
+		if ((op & ASSET_OP_CHANGED) == 0U) {
+			y += n;
+			continue;
+		}
+
+		*first = MIN(*first, y);
+		*last = y + n;
+
+		for (; n > 0U; n--, y++) {
+			ret = asset_line(a, line(y, user_data), len);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	/* unchanged lines of the first frame are only unchanged from white */
+	if (a->frame == 0U) {
+		*first = 0U;
+		*last = a->info.height;
+	}
+
+	a->frame++;
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#ifndef APP_SRC_ASSET_H_
+#define APP_SRC_ASSET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/storage/flash_map.h>
+
+/** Maximum asset name length, including the terminating NUL. */
+#define ASSET_NAME_LEN 24U
+
+/** Flash read chunk size. */
+#define ASSET_READ_SIZE 256U
+
+/** @brief Asset properties. */
+struct asset_info {
+	/** Width, in pixels. */
+	uint16_t width;
+	/** Height, in pixels. */
+	uint16_t height;
+	/** Number of frames. */
+	uint16_t frames;
+	/** Frame period, in milliseconds, 0 to play as fast as possible. */
+	uint16_t period_ms;
+};
+
+/**
+ * @brief Frame line destination.
+ *
+ * @param y Line.
+ * @param user_data User data given to asset_decode().
+ *
+ * @return Where the line is, 1 bit per pixel, holding the previous frame.
+ */
+typedef uint8_t *(*asset_line_t)(uint16_t y, void *user_data);
+
+/**
+ * @brief Asset being decoded.
+ *
+ * Assets are stored in the assets partition of the external flash, and are
+ * read through a small buffer while decoding, so that their size is not
+ * bounded by RAM.
+ */
+struct asset {
+	/** Asset properties. */
+	struct asset_info info;
+	/** Next frame to decode. */
+	uint16_t frame;
+	/** Number of bytes read from flash. */
+	uint32_t bytes_read;
+	/* internal */
+	const struct flash_area *fa;
+	uint32_t start;
+	uint32_t end;
+	uint32_t pos;
+	uint16_t head;
+	uint16_t tail;
+	uint8_t buf[ASSET_READ_SIZE];
+};
+
+/**
+ * @brief Get the name of an asset.
+ *
+ * @param idx Asset index.
+ * @param name Where to store the name, ASSET_NAME_LEN bytes.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT If there is no asset at @p idx.
+ * @retval -errno Other negative errno code on failure.
+ */
+int asset_get_name(size_t idx, char *name);
+
+/**
+ * @brief Open an asset.
+ *
+ * Keeps the flash active until asset_close() is called.
+ *
+ * @param a Asset.
+ * @param name Asset name.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT If the asset does not exist.
+ * @retval -EINVAL If the asset is corrupted.
+ * @retval -errno Other negative errno code on failure.
+ */
+int asset_open(struct asset *a, const char *name);
+
+/**
+ * @brief Close an asset.
+ *
+ * @param a Asset.
+ */
+void asset_close(struct asset *a);
+
+/**
+ * @brief Go back to the first frame.
+ *
+ * @param a Asset.
+ */
+void asset_rewind(struct asset *a);
+
+/**
+ * @brief Decode the next frame.
+ *
+ * Frames are coded as changes to the previous frame, so the lines must hold
+ * the previous frame, and only the lines that changed are written. The first
+ * frame is coded as changes to a white frame, which all lines are reset to.
+ * Lines are located one at a time, and do not need to be contiguous.
+ *
+ * @param a Asset.
+ * @param line Frame line destination, as wide as the asset.
+ * @param user_data User data passed to @p line.
+ * @param first Where to store the first line that changed.
+ * @param last Where to store the line after the last one that changed.
+ *
+ * @retval 0 on success.
+ * @retval -ENODATA If all frames were decoded.
+ * @retval -EINVAL If the frame is corrupted.
+ * @retval -errno Other negative errno code on failure.
+ */
+int asset_decode(struct asset *a, asset_line_t line, void *user_data, uint16_t *first,
+		 uint16_t *last);
+
+#endif /* APP_SRC_ASSET_H_ */
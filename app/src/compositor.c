@@ -0,0 +1,168 @@
+#include "compositor.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+#define COMPOSITOR_WIDTH  DT_PROP(DT_CHOSEN(zephyr_display), width)
+#define COMPOSITOR_HEIGHT DT_PROP(DT_CHOSEN(zephyr_display), height)
+
+#define COMPOSITOR_STACK_SIZE 1024
+#define COMPOSITOR_PRIO       K_PRIO_PREEMPT(10)
+#define COMPOSITOR_FPS        30U
+#define COMPOSITOR_FPS_MAX    100U
+
+static K_THREAD_STACK_DEFINE(compositor_stack, COMPOSITOR_STACK_SIZE);
+static struct k_work_q compositor_wq;
+static struct k_work_delayable flush_work;
+static K_MUTEX_DEFINE(canvas_lock);
+
+static uint8_t canvas_buf[COMPOSITOR_HEIGHT][DIV_ROUND_UP(COMPOSITOR_WIDTH, 8)];
+static const struct raster canvas = {
+	.buf = &canvas_buf[0][0],
+	.width = COMPOSITOR_WIDTH,
+	.height = COMPOSITOR_HEIGHT,
+	.pitch = sizeof(canvas_buf[0]),
+};
+/* damaged lines being flushed, only used by the compositor work queue */
+static uint8_t flush_buf[COMPOSITOR_HEIGHT][DIV_ROUND_UP(COMPOSITOR_WIDTH, 8)];
+
+static const struct device *display;
+static uint32_t period_ms = MSEC_PER_SEC / COMPOSITOR_FPS;
+static int64_t last_flush;
+/* damaged lines, [first, last), protected by canvas_lock */
+static uint16_t first = COMPOSITOR_HEIGHT;
+static uint16_t last;
+static struct compositor_stats stats;
+
+static void compositor_flush(struct k_work *work)
+{
+	struct display_buffer_descriptor desc = {
+		.width = COMPOSITOR_WIDTH,
+		.pitch = COMPOSITOR_WIDTH,
+	};
+	timing_t start, end;
+	uint16_t y;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	(void)k_mutex_lock(&canvas_lock, K_FOREVER);
+
+	if (first >= last) {
+		k_mutex_unlock(&canvas_lock);
+		return;
+	}
+
+	/* copy the damaged lines out, so that producers do not wait for the transfer */
+	y = first;
+	desc.height = last - first;
+	memcpy(flush_buf, canvas_buf[y], desc.height * sizeof(canvas_buf[0]));
+
+	first = COMPOSITOR_HEIGHT;
+	last = 0U;
+
+	k_mutex_unlock(&canvas_lock);
+
+	start = timing_counter_get();
+	ret = display_write(display, 0, y, &desc, flush_buf);
+	end = timing_counter_get();
+
+	(void)k_mutex_lock(&canvas_lock, K_FOREVER);
+
+	last_flush = k_uptime_get();
+
+	stats.flushes++;
+	if (ret < 0) {
+		stats.errors++;
+	} else {
+		stats.lines += desc.height;
+	}
+
+	stats.last_flush_us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+	stats.flush_us += stats.last_flush_us;
+
+	k_mutex_unlock(&canvas_lock);
+}
+
+int compositor_init(const struct device *disp)
+{
+	const struct k_work_queue_config cfg = {.name = "compositor"};
+
+	display = disp;
+
+	/* white, like the panel after power up */
+	raster_fill_rect(&canvas, 0U, 0U, canvas.width, canvas.height, RASTER_WHITE);
+
+	timing_init();
+	timing_start();
+
+	k_work_init_delayable(&flush_work, compositor_flush);
+	k_work_queue_start(&compositor_wq, compositor_stack,
+			   K_THREAD_STACK_SIZEOF(compositor_stack), COMPOSITOR_PRIO, &cfg);
+
+	return 0;
+}
+
+const struct raster *compositor_begin(void)
+{
+	(void)k_mutex_lock(&canvas_lock, K_FOREVER);
+
+	return &canvas;
+}
+
+void compositor_end(uint16_t y, uint16_t h)
+{
+	int64_t due;
+
+	if (h == 0U || y >= canvas.height) {
+		k_mutex_unlock(&canvas_lock);
+		return;
+	}
+
+	first = MIN(first, y);
+	last = MAX(last, MIN(y + h, canvas.height));
+	stats.updates++;
+
+	due = last_flush + period_ms - k_uptime_get();
+
+	k_mutex_unlock(&canvas_lock);
+
+	/* does nothing if a flush is already scheduled, which merges the updates */
+	(void)k_work_schedule_for_queue(&compositor_wq, &flush_work, K_MSEC(MAX(due, 0)));
+}
+
+void compositor_sync(void)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush_delayable(&flush_work, &sync);
+}
+
+int compositor_set_max_fps(uint32_t fps)
+{
+	if (fps == 0U || fps > COMPOSITOR_FPS_MAX) {
+		return -EINVAL;
+	}
+
+	period_ms = MSEC_PER_SEC / fps;
+
+	return 0;
+}
+
+uint32_t compositor_get_max_fps(void)
+{
+	return MSEC_PER_SEC / period_ms;
+}
+
+void compositor_get_stats(struct compositor_stats *out)
+{
+	(void)k_mutex_lock(&canvas_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&canvas_lock);
+}
@@ -0,0 +1,92 @@
+#ifndef APP_SRC_COMPOSITOR_H_
+#define APP_SRC_COMPOSITOR_H_
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+#include "raster.h"
+
+/** @brief Compositor statistics. */
+struct compositor_stats {
+	/** Number of updates submitted by producers. */
+	uint32_t updates;
+	/** Number of flushes to the display. */
+	uint32_t flushes;
+	/** Number of failed flushes. */
+	uint32_t errors;
+	/** Number of lines flushed. */
+	uint32_t lines;
+	/** Duration of the last flush, in microseconds. */
+	uint32_t last_flush_us;
+	/** Total flush duration, in microseconds. */
+	uint64_t flush_us;
+};
+
+/**
+ * @brief Initialize the compositor.
+ *
+ * Producers draw into a canvas owned by the compositor, and report the areas
+ * they changed. A dedicated work queue merges them and flushes the canvas at
+ * most once per frame period, so that back-to-back updates result in a single
+ * transfer.
+ *
+ * @param disp Display device.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int compositor_init(const struct device *disp);
+
+/**
+ * @brief Start drawing into the canvas.
+ *
+ * Only waits for other producers, flushes copy the damaged lines out of the
+ * canvas before writing them to the display. Must be followed by a call to
+ * compositor_end().
+ *
+ * @return Canvas.
+ */
+const struct raster *compositor_begin(void);
+
+/**
+ * @brief Finish drawing into the canvas.
+ *
+ * @param y First line that changed.
+ * @param h Number of lines that changed, 0 if none did.
+ */
+void compositor_end(uint16_t y, uint16_t h);
+
+/**
+ * @brief Flush pending updates now.
+ *
+ * Does not wait for the end of the frame period, and returns once the flush is
+ * done.
+ */
+void compositor_sync(void);
+
+/**
+ * @brief Set the maximum frame rate.
+ *
+ * @param fps Frames per second.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL If @p fps is out of range.
+ */
+int compositor_set_max_fps(uint32_t fps);
+
+/**
+ * @brief Get the maximum frame rate.
+ *
+ * @return Frames per second.
+ */
+uint32_t compositor_get_max_fps(void);
+
+/**
+ * @brief Obtain statistics.
+ *
+ * @param stats Where to store the statistics.
+ */
+void compositor_get_stats(struct compositor_stats *stats);
+
+#endif /* APP_SRC_COMPOSITOR_H_ */
@@ -0,0 +1,65 @@
+#include "cpuload.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define CPULOAD_STACK_SIZE     256
+#define CPULOAD_CALIBRATION_MS 100
+
+static K_THREAD_STACK_DEFINE(cpuload_stack, CPULOAD_STACK_SIZE);
+static struct k_thread cpuload_thread;
+static volatile uint32_t count;
+static uint64_t rate;
+static uint32_t start;
+static int prio;
+
+static void cpuload_count(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		count++;
+	}
+}
+
+void cpuload_start(void)
+{
+	prio = k_thread_priority_get(k_current_get());
+	k_thread_priority_set(k_current_get(), K_LOWEST_APPLICATION_THREAD_PRIO - 1);
+
+	count = 0U;
+	start = k_cycle_get_32();
+
+	k_thread_create(&cpuload_thread, cpuload_stack, K_THREAD_STACK_SIZEOF(cpuload_stack),
+			cpuload_count, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+			K_NO_WAIT);
+
+	if (rate == 0U) {
+		k_msleep(CPULOAD_CALIBRATION_MS);
+
+		/* counts per 2^16 cycles, to keep precision on integer math */
+		rate = ((uint64_t)count << 16) / (k_cycle_get_32() - start);
+
+		count = 0U;
+		start = k_cycle_get_32();
+	}
+}
+
+uint32_t cpuload_stop(void)
+{
+	uint32_t elapsed = k_cycle_get_32() - start;
+	uint64_t idle = ((uint64_t)count << 16) * 1000U;
+
+	k_thread_abort(&cpuload_thread);
+	k_thread_priority_set(k_current_get(), prio);
+
+	if (rate == 0U || elapsed == 0U) {
+		return 0U;
+	}
+
+	idle /= rate * elapsed;
+
+	return 1000U - MIN(idle, 1000U);
+}
@@ -0,0 +1,23 @@
+#ifndef APP_SRC_CPULOAD_H_
+#define APP_SRC_CPULOAD_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Start measuring CPU load.
+ *
+ * A counting thread is started at the lowest application priority, so it only
+ * runs when nothing else does. The calling thread priority is raised above it
+ * until cpuload_stop() is called. The first call calibrates the counting rate
+ * on an idle system, which takes about 100 ms.
+ */
+void cpuload_start(void);
+
+/**
+ * @brief Stop measuring CPU load.
+ *
+ * @return CPU load since cpuload_start(), in per mille.
+ */
+uint32_t cpuload_stop(void);
+
+#endif /* APP_SRC_CPULOAD_H_ */
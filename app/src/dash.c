@@ -0,0 +1,294 @@
+#include "dash.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/sensor/npm1300_charger.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+#include "compositor.h"
+#include "font.h"
+#include "raster.h"
+
+#define DASH_DISPLAY DT_CHOSEN(zephyr_display)
+#define DASH_COLS    (DT_PROP(DASH_DISPLAY, width) / FONT_CELL_WIDTH)
+#define DASH_ROWS    (DT_PROP(DASH_DISPLAY, height) / FONT_CELL_HEIGHT)
+
+BUILD_ASSERT(DASH_ROWS >= 10U, "Display too small for the dashboard");
+
+static const struct device *const imu = DEVICE_DT_GET(DT_ALIAS(imu0));
+static const struct device *const mag = DEVICE_DT_GET(DT_ALIAS(mag0));
+static const struct device *const press = DEVICE_DT_GET(DT_ALIAS(press0));
+static const struct device *const light = DEVICE_DT_GET(DT_ALIAS(light0));
+static const struct device *const charger = DEVICE_DT_GET(DT_ALIAS(charger0));
+
+static struct k_work_delayable refresh_work;
+static uint32_t refresh_ms;
+static bool running;
+/* characters on the panel */
+static char shown[DASH_ROWS][DASH_COLS];
+static struct dash_stats stats;
+/* in timing cycles */
+static uint64_t sample;
+static uint64_t render;
+
+static void dash_line(char *line, const char *fmt, ...)
+{
+	va_list ap;
+	int len;
+
+	va_start(ap, fmt);
+	len = vsnprintf(line, DASH_COLS + 1U, fmt, ap);
+	va_end(ap);
+
+	/* pad with spaces, so that leftovers of longer values get erased */
+	len = CLAMP(len, 0, (int)DASH_COLS);
+	memset(&line[len], ' ', DASH_COLS - len);
+}
+
+static int dash_fetch(const struct device *dev)
+{
+	if (!device_is_ready(dev)) {
+		return -ENODEV;
+	}
+
+	return sensor_sample_fetch(dev);
+}
+
+static void dash_sample(char text[DASH_ROWS][DASH_COLS + 1U])
+{
+	struct sensor_value val[3];
+	struct sensor_value status, error, vbus;
+
+	if (dash_fetch(imu) == 0 && sensor_channel_get(imu, SENSOR_CHAN_ACCEL_XYZ, val) == 0) {
+		dash_line(text[0], "A%5.1f%6.1f%6.1f", sensor_value_to_double(&val[0]),
+			  sensor_value_to_double(&val[1]), sensor_value_to_double(&val[2]));
+	} else {
+		dash_line(text[0], "A   --");
+	}
+
+	if (sensor_channel_get(imu, SENSOR_CHAN_GYRO_XYZ, val) == 0) {
+		dash_line(text[1], "G%5.1f%6.1f%6.1f", sensor_value_to_double(&val[0]),
+			  sensor_value_to_double(&val[1]), sensor_value_to_double(&val[2]));
+	} else {
+		dash_line(text[1], "G   --");
+	}
+
+	/* the magnetometer driver reports hundredths of gauss in val2 */
+	if (dash_fetch(mag) == 0 && sensor_channel_get(mag, SENSOR_CHAN_MAGN_X, &val[0]) == 0 &&
+	    sensor_channel_get(mag, SENSOR_CHAN_MAGN_Y, &val[1]) == 0 &&
+	    sensor_channel_get(mag, SENSOR_CHAN_MAGN_Z, &val[2]) == 0) {
+		dash_line(text[2], "M%5.2f%6.2f%6.2f", val[0].val1 + val[0].val2 / 100.0,
+			  val[1].val1 + val[1].val2 / 100.0, val[2].val1 + val[2].val2 / 100.0);
+	} else {
+		dash_line(text[2], "M   --");
+	}
+
+	if (dash_fetch(press) == 0 && sensor_channel_get(press, SENSOR_CHAN_PRESS, &val[0]) == 0 &&
+	    sensor_channel_get(press, SENSOR_CHAN_AMBIENT_TEMP, &val[1]) == 0) {
+		dash_line(text[3], "P %9.2f KPA", sensor_value_to_double(&val[0]));
+		dash_line(text[4], "T %9.2f C", sensor_value_to_double(&val[1]));
+	} else {
+		dash_line(text[3], "P   --");
+		dash_line(text[4], "T   --");
+	}
+
+	if (dash_fetch(light) == 0 && sensor_channel_get(light, SENSOR_CHAN_LIGHT, &val[0]) == 0) {
+		dash_line(text[5], "L %9.1f LUX", sensor_value_to_double(&val[0]));
+	} else {
+		dash_line(text[5], "L   --");
+	}
+
+	if (dash_fetch(charger) == 0 &&
+	    sensor_channel_get(charger, SENSOR_CHAN_GAUGE_VOLTAGE, &val[0]) == 0 &&
+	    sensor_channel_get(charger, SENSOR_CHAN_GAUGE_AVG_CURRENT, &val[1]) == 0 &&
+	    sensor_channel_get(charger, (enum sensor_channel)SENSOR_CHAN_NPM1300_CHARGER_STATUS,
+			       &status) == 0 &&
+	    sensor_channel_get(charger, (enum sensor_channel)SENSOR_CHAN_NPM1300_CHARGER_ERROR,
+			       &error) == 0 &&
+	    sensor_attr_get(charger,
+			    (enum sensor_channel)SENSOR_CHAN_NPM1300_CHARGER_VBUS_STATUS,
+			    (enum sensor_attribute)SENSOR_ATTR_NPM1300_CHARGER_VBUS_PRESENT,
+			    &vbus) == 0) {
+		dash_line(text[6], "V %9.3f V", sensor_value_to_double(&val[0]));
+		dash_line(text[7], "I %9.4f A", sensor_value_to_double(&val[1]));
+		dash_line(text[8], "CHG %02X ERR %02X %s", status.val1, error.val1,
+			  vbus.val1 ? "USB" : "BAT");
+	} else {
+		dash_line(text[6], "V   --");
+		dash_line(text[7], "I   --");
+		dash_line(text[8], "CHG --");
+	}
+
+	dash_line(text[9], "UP %9u S", k_uptime_seconds());
+}
+
+static void dash_refresh(struct k_work *work)
+{
+	char text[DASH_ROWS][DASH_COLS + 1U];
+	const struct raster *fb;
+	uint16_t first = DASH_ROWS, last = 0U;
+	timing_t start, sampled, rendered;
+
+	start = timing_counter_get();
+
+	dash_sample(text);
+
+	sampled = timing_counter_get();
+
+	fb = compositor_begin();
+
+	/* only redraw the cells that changed */
+	for (uint16_t row = 0U; row < DASH_ROWS; row++) {
+		for (uint16_t col = 0U; col < DASH_COLS; col++) {
+			if (text[row][col] == shown[row][col]) {
+				continue;
+			}
+
+			font_draw(fb, col, row, text[row][col]);
+			shown[row][col] = text[row][col];
+			stats.cells++;
+
+			first = MIN(first, row);
+			last = MAX(last, row);
+		}
+	}
+
+	/* and only flush the rows containing them */
+	if (first <= last) {
+		compositor_end(first * FONT_CELL_HEIGHT, (last - first + 1U) * FONT_CELL_HEIGHT);
+	} else {
+		compositor_end(0U, 0U);
+	}
+
+	rendered = timing_counter_get();
+
+	stats.refreshes++;
+	sample += timing_cycles_get(&start, &sampled);
+	render += timing_cycles_get(&sampled, &rendered);
+
+	(void)k_work_reschedule(k_work_delayable_from_work(work), K_MSEC(refresh_ms));
+}
+
+static void dash_power(bool on)
+{
+	struct sensor_value odr = {.val1 = on ? 12 : 0};
+
+	/* same settings as the sensor commands */
+	if (device_is_ready(imu)) {
+		(void)sensor_attr_set(imu, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY,
+				      &odr);
+		(void)sensor_attr_set(imu, SENSOR_CHAN_GYRO_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY,
+				      &odr);
+	}
+
+	if (device_is_ready(mag)) {
+		if (on) {
+			struct sensor_value val = {.val1 = 25};
+
+			(void)pm_device_action_run(mag, PM_DEVICE_ACTION_RESUME);
+			(void)sensor_attr_set(mag, SENSOR_CHAN_MAGN_XYZ,
+					      SENSOR_ATTR_SAMPLING_FREQUENCY, &val);
+			val.val1 = 1;
+			(void)sensor_attr_set(mag, SENSOR_CHAN_MAGN_XYZ, SENSOR_ATTR_OVERSAMPLING,
+					      &val);
+		} else {
+			(void)pm_device_action_run(mag, PM_DEVICE_ACTION_SUSPEND);
+		}
+	}
+
+	if (device_is_ready(press)) {
+		if (on) {
+			(void)pm_device_runtime_get(press);
+		} else {
+			(void)pm_device_runtime_put(press);
+		}
+	}
+}
+
+int dash_init(void)
+{
+	k_work_init_delayable(&refresh_work, dash_refresh);
+
+	return 0;
+}
+
+int dash_start(uint32_t period_ms)
+{
+	const struct raster *fb;
+
+	if (period_ms < DASH_PERIOD_MS_MIN || period_ms > DASH_PERIOD_MS_MAX) {
+		return -EINVAL;
+	}
+
+	refresh_ms = period_ms;
+
+	if (running) {
+		(void)k_work_reschedule(&refresh_work, K_NO_WAIT);
+		return 0;
+	}
+
+	/* start from a white screen, which matches a screen full of spaces */
+	fb = compositor_begin();
+	raster_fill_rect(fb, 0U, 0U, fb->width, fb->height, RASTER_WHITE);
+	compositor_end(0U, fb->height);
+
+	memset(shown, ' ', sizeof(shown));
+	memset(&stats, 0, sizeof(stats));
+	sample = 0U;
+	render = 0U;
+
+	dash_power(true);
+
+	timing_init();
+	timing_start();
+
+	running = true;
+	(void)k_work_reschedule(&refresh_work, K_NO_WAIT);
+
+	return 0;
+}
+
+int dash_stop(void)
+{
+	struct k_work_sync sync;
+
+	if (!running) {
+		return -EALREADY;
+	}
+
+	(void)k_work_cancel_delayable_sync(&refresh_work, &sync);
+	running = false;
+
+	timing_stop();
+
+	dash_power(false);
+
+	return 0;
+}
+
+bool dash_is_running(void)
+{
+	return running;
+}
+
+uint32_t dash_get_period(void)
+{
+	return refresh_ms;
+}
+
+void dash_get_stats(struct dash_stats *out)
+{
+	*out = stats;
+	out->sample_us = timing_cycles_to_ns(sample) / NSEC_PER_USEC;
+	out->render_us = timing_cycles_to_ns(render) / NSEC_PER_USEC;
+}
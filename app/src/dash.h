@@ -0,0 +1,79 @@
+#ifndef APP_SRC_DASH_H_
+#define APP_SRC_DASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Default refresh period, in milliseconds. */
+#define DASH_PERIOD_MS     1000U
+/** Minimum refresh period, in milliseconds. */
+#define DASH_PERIOD_MS_MIN 100U
+/** Maximum refresh period, in milliseconds. */
+#define DASH_PERIOD_MS_MAX 60000U
+
+/** @brief Dashboard statistics. */
+struct dash_stats {
+	/** Number of refreshes. */
+	uint32_t refreshes;
+	/** Number of character cells redrawn. */
+	uint32_t cells;
+	/** Total sensor sampling duration, in microseconds. */
+	uint64_t sample_us;
+	/** Total rendering duration, in microseconds. */
+	uint64_t render_us;
+};
+
+/**
+ * @brief Initialize the sensor dashboard.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int dash_init(void);
+
+/**
+ * @brief Start showing the sensor dashboard.
+ *
+ * Sensors are sampled once per period, and only the character cells whose
+ * value changed are redrawn through the compositor. If already started, only
+ * the period is changed, and a refresh happens right away.
+ *
+ * @param period_ms Refresh period, DASH_PERIOD_MS_MIN to DASH_PERIOD_MS_MAX.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL If @p period_ms is out of range.
+ */
+int dash_start(uint32_t period_ms);
+
+/**
+ * @brief Stop showing the sensor dashboard.
+ *
+ * The last refresh stays on the panel.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY If not started.
+ */
+int dash_stop(void);
+
+/**
+ * @brief Check whether the sensor dashboard is being shown.
+ *
+ * @return true if started, false otherwise.
+ */
+bool dash_is_running(void);
+
+/**
+ * @brief Get the refresh period.
+ *
+ * @return Refresh period, in milliseconds.
+ */
+uint32_t dash_get_period(void);
+
+/**
+ * @brief Obtain statistics since the last start.
+ *
+ * @param stats Where to store the statistics.
+ */
+void dash_get_stats(struct dash_stats *stats);
+
+#endif /* APP_SRC_DASH_H_ */
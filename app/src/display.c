@@ -1,23 +1,88 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
 #include <zephyr/shell/shell.h>
+#include <zephyr/timing/timing.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#include "asset.h"
+#include "compositor.h"
+#include "cpuload.h"
+#include "dash.h"
+#include "dither.h"
+#include "font.h"
+#include "gray.h"
+#include "pattern.h"
+#include "play.h"
+#include "raster.h"
+#include "stream.h"
 
 #define DISP_WIDTH  DT_PROP(DT_CHOSEN(zephyr_display), width)
 #define DISP_HEIGHT DT_PROP(DT_CHOSEN(zephyr_display), height)
 
+#define BENCH_FRAMES_MAX   256U
+#define BENCH_SPARSE_LINES 8U
+#define BENCH_BAND_HEIGHT  32U
+
+#define ROTATE_FRAMES_MAX 1000U
+
+#define GRAY_HZ 60U
+
 static const struct device *const disp = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
 static const struct display_buffer_descriptor desc = {
 	.width = DISP_WIDTH,
 	.height = DISP_HEIGHT,
-	.pitch = DISP_WIDTH + 2 * 8,
+	.pitch = DISP_WIDTH,
 };
 static bool initialized;
 
+static uint8_t bench_buf[DISP_HEIGHT][DISP_WIDTH / 8];
+static const struct raster bench_fb = {
+	.buf = &bench_buf[0][0],
+	.width = DISP_WIDTH,
+	.height = DISP_HEIGHT,
+	.pitch = sizeof(bench_buf[0]),
+};
+static uint32_t bench_lat[BENCH_FRAMES_MAX];
+static uint8_t rotate_buf[DISP_HEIGHT][DISP_WIDTH / 8];
+
+static const char *gray_source;
+
+static bool display_held(void)
+{
+	enum pm_device_state state;
+
+	return pm_device_state_get(disp, &state) == 0 && state == PM_DEVICE_STATE_SUSPENDED;
+}
+
+/*
+ * Commands drawing on the panel outside the compositor would fight with the
+ * dashboard and grayscale mode, which keep writing from work queues.
+ */
+static int display_busy(const struct shell *sh)
+{
+	if (dash_is_running()) {
+		shell_error(sh, "Stop the dashboard first");
+		return -EBUSY;
+	}
+
+	if (gray_is_running()) {
+		shell_error(sh, "Stop grayscale mode first");
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
 static int cmd_display_on(const struct shell *sh, size_t argc, char **argv)
 {
+	timing_t start, end;
 	int err;
 
 	ARG_UNUSED(argc);
@@ -28,19 +93,29 @@ static int cmd_display_on(const struct shell *sh, size_t argc, char **argv)
 		return -EPERM;
 	}
 
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
 	err = display_blanking_off(disp);
+	end = timing_counter_get();
+
+	timing_stop();
+
 	if (err < 0) {
 		shell_error(sh, "Failed to turn on display (%d)", err);
 		return 0;
 	}
 
-	shell_print(sh, "Display ON");
+	shell_print(sh, "Display ON (%llu us)",
+		    timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC);
 
 	return 0;
 }
 
 static int cmd_display_off(const struct shell *sh, size_t argc, char **argv)
 {
+	timing_t start, end;
 	int err;
 
 	ARG_UNUSED(argc);
@@ -51,21 +126,83 @@ static int cmd_display_off(const struct shell *sh, size_t argc, char **argv)
 		return -EPERM;
 	}
 
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
 	err = display_blanking_on(disp);
+	end = timing_counter_get();
+
+	timing_stop();
+
 	if (err < 0) {
 		shell_error(sh, "Failed to turn off display (%d)", err);
 		return 0;
 	}
 
-	shell_print(sh, "Display OFF");
+	shell_print(sh, "Display OFF (%llu us)",
+		    timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC);
 
 	return 0;
 }
 
-static int cmd_display_vpattern(const struct shell *sh, size_t argc, char **argv)
+static int cmd_display_hold(const struct shell *sh, size_t argc, char **argv)
+{
+	enum pm_device_action action;
+	timing_t start, end;
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (strcmp(argv[1], "on") == 0) {
+		action = PM_DEVICE_ACTION_SUSPEND;
+	} else if (strcmp(argv[1], "off") == 0) {
+		action = PM_DEVICE_ACTION_RESUME;
+	} else {
+		shell_error(sh, "Invalid argument (on, off)");
+		return -EINVAL;
+	}
+
+	/* writes fail in hold mode, producers must be stopped first */
+	if (action == PM_DEVICE_ACTION_SUSPEND) {
+		err = display_busy(sh);
+		if (err < 0) {
+			return err;
+		}
+
+		/* send what the compositor still has pending */
+		compositor_sync();
+	}
+
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
+	err = pm_device_action_run(disp, action);
+	end = timing_counter_get();
+
+	timing_stop();
+
+	if (err == -EALREADY) {
+		shell_print(sh, "Hold mode already %s", argv[1]);
+		return 0;
+	} else if (err < 0) {
+		shell_error(sh, "Failed to turn hold mode %s (%d)", argv[1], err);
+		return 0;
+	}
+
+	shell_print(sh, "Hold mode %s (%llu us)", argv[1],
+		    timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC);
+
+	return 0;
+}
+
+static int cmd_display_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	int err;
-	uint8_t *buf;
 
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
@@ -75,20 +212,47 @@ static int cmd_display_vpattern(const struct shell *sh, size_t argc, char **argv
 		return -EPERM;
 	}
 
-	buf = display_get_framebuffer(disp);
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
 
-	for (uint16_t i = 0; i < desc.height; i++) {
-		memset(&buf[i * desc.pitch / 8], 0xff, desc.width / 8);
+	err = ls013b7dh05_clear(disp);
+	if (err < 0) {
+		shell_error(sh, "Failed to clear display (%d)", err);
+		return 0;
 	}
 
-	for (uint16_t y = 0U; y <= desc.height; y++) {
-		for (uint16_t x = 0U; x <= desc.width; x++) {
-			if (x % 4 != 0) {
-				buf[y * desc.pitch / 8 + x / 8] &= ~(1 << (x % 8));
-			}
-		}
+	shell_print(sh, "Display cleared");
+
+	return 0;
+}
+
+static int cmd_display_vpattern(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+	uint8_t *buf;
+	struct raster fb;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
 	}
 
+	buf = display_get_framebuffer(disp);
+	fb = (struct raster){buf, desc.width, desc.height, desc.pitch / 8};
+
+	/* every 4th column white */
+	raster_fill_pattern(&fb, 0, 0, desc.width, desc.height, 0x11111111U);
+
 	err = display_write(disp, 0, 0, &desc, buf);
 	if (err < 0) {
 		shell_error(sh, "Failed to write to display (%d)", err);
@@ -104,6 +268,7 @@ static int cmd_display_hpattern(const struct shell *sh, size_t argc, char **argv
 {
 	int err;
 	uint8_t *buf;
+	struct raster fb;
 
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
@@ -113,18 +278,18 @@ static int cmd_display_hpattern(const struct shell *sh, size_t argc, char **argv
 		return -EPERM;
 	}
 
-	buf = display_get_framebuffer(disp);
-
-	for (uint16_t i = 0; i < desc.height; i++) {
-		memset(&buf[i * desc.pitch / 8], 0xff, desc.width / 8);
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
 	}
 
-	for (uint16_t y = 0U; y <= desc.height; y++) {
-		for (uint16_t x = 0U; x <= desc.width; x++) {
-			if (y % 4 != 0) {
-				buf[y * desc.pitch / 8 + x / 8] &= ~(1 << (x % 8));
-			}
-		}
+	buf = display_get_framebuffer(disp);
+	fb = (struct raster){buf, desc.width, desc.height, desc.pitch / 8};
+
+	/* every 4th line white */
+	raster_fill_rect(&fb, 0, 0, desc.width, desc.height, RASTER_BLACK);
+	for (uint16_t y = 0U; y < desc.height; y += 4U) {
+		raster_hline(&fb, 0, y, desc.width, RASTER_WHITE);
 	}
 
 	err = display_write(disp, 0, 0, &desc, buf);
@@ -138,6 +303,97 @@ static int cmd_display_hpattern(const struct shell *sh, size_t argc, char **argv
 	return 0;
 }
 
+static int cmd_display_pattern(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+	const struct raster *fb;
+	struct compositor_stats before, after;
+	timing_t start, end;
+
+	ARG_UNUSED(argc);
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	timing_init();
+	timing_start();
+
+	fb = compositor_begin();
+
+	start = timing_counter_get();
+	err = pattern_render(argv[1], fb);
+	end = timing_counter_get();
+
+	compositor_end(0, (err < 0) ? 0U : fb->height);
+
+	timing_stop();
+
+	if (err < 0) {
+		shell_error(sh, "Unknown pattern: %s", argv[1]);
+		return -EINVAL;
+	}
+
+	compositor_get_stats(&before);
+	compositor_sync();
+	compositor_get_stats(&after);
+
+	if (after.errors != before.errors) {
+		shell_error(sh, "Failed to write to display");
+		return 0;
+	}
+
+	shell_print(sh, "Pattern %s displayed", argv[1]);
+	shell_print(sh, "Generation: %llu us, flush: %u us",
+		    timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC,
+		    after.last_flush_us);
+
+	return 0;
+}
+
+static int cmd_display_fps(const struct shell *sh, size_t argc, char **argv)
+{
+	struct compositor_stats stats;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (argc > 1) {
+		int err;
+
+		err = compositor_set_max_fps(strtoul(argv[1], NULL, 0));
+		if (err < 0) {
+			shell_error(sh, "Invalid frame rate");
+			return err;
+		}
+	}
+
+	compositor_get_stats(&stats);
+
+	shell_print(sh, "Max FPS: %u", compositor_get_max_fps());
+	shell_print(sh, "Updates: %u, flushes: %u (%u errors), lines: %u", stats.updates,
+		    stats.flushes, stats.errors, stats.lines);
+	if (stats.flushes > 0U) {
+		shell_print(sh, "Flush: last %u us, avg %llu us", stats.last_flush_us,
+			    stats.flush_us / stats.flushes);
+	}
+
+	return 0;
+}
+
+static void pattern_get(size_t idx, struct shell_static_entry *entry)
+{
+	entry->syntax = pattern_name(idx);
+	entry->handler = NULL;
+	entry->help = NULL;
+	entry->subcmd = NULL;
+}
+
+SHELL_DYNAMIC_CMD_CREATE(dsub_pattern_name, pattern_get);
+
 static int cmd_display_brightness(const struct shell *sh, size_t argc, char **argv)
 {
 	int err;
@@ -170,20 +426,1116 @@ static int cmd_display_brightness(const struct shell *sh, size_t argc, char **ar
 	return 0;
 }
 
-SHELL_STATIC_SUBCMD_SET_CREATE(
-	sub_display_cmds, SHELL_CMD(on, NULL, "Turn on display", cmd_display_on),
-	SHELL_CMD(off, NULL, "Turn off display", cmd_display_off),
-	SHELL_CMD(vpattern, NULL, "Display vertical pattern", cmd_display_vpattern),
-	SHELL_CMD(hpattern, NULL, "Display horizontal pattern", cmd_display_hpattern),
-	SHELL_CMD_ARG(brightness, NULL, "Set display brightness", cmd_display_brightness, 2, 0),
-	SHELL_SUBCMD_SET_END);
+static int cmd_display_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct ls013b7dh05_stats stats;
 
-SHELL_SUBCMD_ADD((hwv), display, &sub_display_cmds, "Display", NULL, 0, 0);
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
 
-int display_init(void)
+	ls013b7dh05_get_stats(disp, &stats);
+
+	shell_print(sh, "Flushes: %u, transactions: %u", stats.flushes, stats.transactions);
+	shell_print(sh, "Lines sent: %u, skipped: %u", stats.lines_sent, stats.lines_skipped);
+	shell_print(sh, "Bytes sent: %llu, saved: %llu", stats.bytes_sent, stats.bytes_saved);
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		ls013b7dh05_reset_stats(disp);
+	}
+
+	return 0;
+}
+
+static int cmd_display_anim(const struct shell *sh, size_t argc, char **argv)
 {
-	if (!device_is_ready(disp)) {
-		return -ENODEV;
+	int err = 0;
+	uint8_t *buf = NULL;
+	struct raster fb;
+	uint32_t frames = 100U;
+	int64_t start;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U) {
+			shell_error(sh, "Invalid number of frames");
+			return -EINVAL;
+		}
+	}
+
+	start = k_uptime_get();
+
+	for (uint32_t frame = 0U; frame < frames; frame++) {
+		uint8_t *next = display_get_framebuffer(disp);
+
+		/* without double buffering, wait until the framebuffer is no longer being sent */
+		if (next == buf) {
+			err = ls013b7dh05_wait(disp, K_FOREVER);
+			if (err < 0) {
+				break;
+			}
+		}
+
+		buf = next;
+
+		fb = (struct raster){buf, desc.width, desc.height, desc.pitch / 8};
+
+		/* 8-line stripes scrolling down one line per frame */
+		for (uint16_t y = 0U; y < desc.height; y++) {
+			bool black = ((y + 16U - frame % 16U) / 8U) % 2U;
+
+			raster_hline(&fb, 0, y, desc.width, black ? RASTER_BLACK : RASTER_WHITE);
+		}
+
+		err = ls013b7dh05_write_async(disp, 0, 0, &desc, buf, NULL, NULL);
+		if (err < 0) {
+			break;
+		}
+	}
+
+	if (err == 0) {
+		err = ls013b7dh05_wait(disp, K_FOREVER);
+	}
+
+	if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+		return 0;
+	}
+
+	shell_print(sh, "%u frames in %lld ms", frames, k_uptime_get() - start);
+
+	return 0;
+}
+
+static int cmd_display_scroll(const struct shell *sh, size_t argc, char **argv)
+{
+	int err = 0;
+	uint8_t *buf;
+	uint32_t frames = DISP_HEIGHT;
+	uint64_t render = 0U, flush = 0U;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U) {
+			shell_error(sh, "Invalid number of frames");
+			return -EINVAL;
+		}
+	}
+
+	buf = display_get_framebuffer(disp);
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t frame = 0U; frame < frames; frame++) {
+		struct raster line;
+		timing_t start, drawn, end;
+
+		start = timing_counter_get();
+
+		err = ls013b7dh05_scroll(disp, 1);
+		if (err < 0) {
+			break;
+		}
+
+		/* only the line exposed at the bottom needs to be drawn */
+		line = (struct raster){ls013b7dh05_get_line(disp, DISP_HEIGHT - 1U), DISP_WIDTH, 1U,
+				       DISP_WIDTH / 8U};
+		raster_fill_pattern(&line, 0, 0, DISP_WIDTH, 1U,
+				    ((frame / 8U) % 2U) ? 0x00ff00ffU : 0xff00ff00U);
+
+		drawn = timing_counter_get();
+
+		err = display_write(disp, 0, 0, &desc, buf);
+		if (err < 0) {
+			break;
+		}
+
+		end = timing_counter_get();
+
+		render += timing_cycles_get(&start, &drawn);
+		flush += timing_cycles_get(&drawn, &end);
+	}
+
+	timing_stop();
+
+	if (err == -ENOTSUP) {
+		shell_error(sh, "Scrolling is not supported with double buffering");
+		return 0;
+	} else if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+		return 0;
+	}
+
+	shell_print(sh, "Scrolled %u lines: scroll and draw %llu ns/line, flush %llu us/line",
+		    frames, timing_cycles_to_ns(render) / frames,
+		    timing_cycles_to_ns(flush) / frames / NSEC_PER_USEC);
+
+	return 0;
+}
+
+static int cmd_display_cpu(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const modes[] = {"blocking", "async"};
+	int err = 0;
+	uint8_t *buf;
+	uint32_t frames = 10U;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U) {
+			shell_error(sh, "Invalid number of frames");
+			return -EINVAL;
+		}
+	}
+
+	buf = display_get_framebuffer(disp);
+
+	timing_init();
+	timing_start();
+
+	for (size_t mode = 0U; mode < ARRAY_SIZE(modes); mode++) {
+		timing_t start, end, call;
+		uint64_t blocked = 0U;
+		uint64_t total;
+		uint32_t load;
+
+		cpuload_start();
+
+		start = timing_counter_get();
+
+		for (uint32_t i = 0U; i < frames; i++) {
+			ls013b7dh05_invalidate(disp);
+
+			call = timing_counter_get();
+
+			if (mode == 0U) {
+				err = display_write(disp, 0, 0, &desc, buf);
+			} else {
+				err = ls013b7dh05_write_async(disp, 0, 0, &desc, buf, NULL, NULL);
+			}
+
+			end = timing_counter_get();
+			blocked += timing_cycles_get(&call, &end);
+
+			if (err == 0 && mode == 1U) {
+				err = ls013b7dh05_wait(disp, K_FOREVER);
+			}
+
+			if (err < 0) {
+				break;
+			}
+		}
+
+		end = timing_counter_get();
+
+		load = cpuload_stop();
+
+		if (err < 0) {
+			shell_error(sh, "Failed to write to display (%d)", err);
+			break;
+		}
+
+		total = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / frames / 1000U;
+		blocked = timing_cycles_to_ns(blocked) / frames / 1000U;
+
+		shell_print(sh, "%s: %llu us/frame, caller blocked %llu us/frame", modes[mode],
+			    total, blocked);
+		shell_print(sh, "%s: CPU %u.%u%% (%llu us/frame)", modes[mode], load / 10U,
+			    load % 10U, total * load / 1000U);
+	}
+
+	timing_stop();
+
+	return 0;
+}
+
+enum bench_kind {
+	BENCH_FULL,
+	BENCH_LINE,
+	BENCH_SPARSE,
+	BENCH_BAND,
+};
+
+static const char *const bench_names[] = {
+	[BENCH_FULL] = "full",
+	[BENCH_LINE] = "line",
+	[BENCH_SPARSE] = "sparse",
+	[BENCH_BAND] = "band",
+};
+
+/* xorshift32, seeded for each kind so that runs are reproducible */
+static uint32_t bench_rand(uint32_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static void bench_render(enum bench_kind kind, uint32_t frame, uint32_t *seed)
+{
+	switch (kind) {
+	case BENCH_FULL:
+		/* the baseline is white, start with black so that every frame is sent */
+		raster_fill_rect(&bench_fb, 0, 0, DISP_WIDTH, DISP_HEIGHT,
+				 (frame % 2U) ? RASTER_WHITE : RASTER_BLACK);
+		break;
+	case BENCH_LINE:
+		raster_hline(&bench_fb, 0, frame % DISP_HEIGHT, DISP_WIDTH, RASTER_INVERT);
+		break;
+	case BENCH_SPARSE:
+		for (uint8_t n = 0U; n < BENCH_SPARSE_LINES; n++) {
+			uint8_t *line = bench_buf[bench_rand(seed) % DISP_HEIGHT];
+
+			line[bench_rand(seed) % sizeof(bench_buf[0])] ^= 0xff;
+		}
+		break;
+	case BENCH_BAND:
+		/* diagonal stripes moving right, one pixel per frame */
+		for (uint16_t y = 0U; y < BENCH_BAND_HEIGHT; y++) {
+			uint8_t shift = (y + frame) % 8U;
+			uint8_t val = (uint8_t)((0x0fU << shift) | (0x0fU >> (8U - shift)));
+			uint16_t row = (DISP_HEIGHT - BENCH_BAND_HEIGHT) / 2U + y;
+
+			raster_fill_pattern(&bench_fb, 0, row, DISP_WIDTH, 1U, val * 0x01010101U);
+		}
+		break;
+	}
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t va = *(const uint32_t *)a;
+	uint32_t vb = *(const uint32_t *)b;
+
+	return (va > vb) - (va < vb);
+}
+
+static int cmd_display_bench(const struct shell *sh, size_t argc, char **argv)
+{
+	static const struct display_buffer_descriptor bench_desc = {
+		.width = DISP_WIDTH,
+		.height = DISP_HEIGHT,
+		.pitch = DISP_WIDTH,
+	};
+	int err = 0;
+	uint32_t frames = 50U;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U || frames > BENCH_FRAMES_MAX) {
+			shell_error(sh, "Invalid number of frames (1-%u)", BENCH_FRAMES_MAX);
+			return -EINVAL;
+		}
+	}
+
+	timing_init();
+	timing_start();
+
+	for (size_t kind = 0U; kind < ARRAY_SIZE(bench_names); kind++) {
+		struct ls013b7dh05_stats before, after;
+		timing_t start, end, call;
+		uint64_t total_us, fps, lat_sum = 0U;
+		uint32_t seed = 0x12345678U;
+		uint32_t load;
+
+		memset(bench_buf, 0xff, sizeof(bench_buf));
+		err = display_write(disp, 0, 0, &bench_desc, bench_buf);
+		if (err < 0) {
+			break;
+		}
+
+		ls013b7dh05_get_stats(disp, &before);
+		cpuload_start();
+
+		start = timing_counter_get();
+
+		for (uint32_t frame = 0U; frame < frames; frame++) {
+			bench_render(kind, frame, &seed);
+
+			call = timing_counter_get();
+			err = display_write(disp, 0, 0, &bench_desc, bench_buf);
+			end = timing_counter_get();
+			if (err < 0) {
+				break;
+			}
+
+			bench_lat[frame] = timing_cycles_to_ns(timing_cycles_get(&call, &end)) /
+					   NSEC_PER_USEC;
+			lat_sum += bench_lat[frame];
+		}
+
+		end = timing_counter_get();
+
+		load = cpuload_stop();
+		ls013b7dh05_get_stats(disp, &after);
+
+		if (err < 0) {
+			break;
+		}
+
+		total_us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+		total_us = MAX(total_us, 1U);
+		fps = (uint64_t)frames * USEC_PER_SEC * 100U / total_us;
+		qsort(bench_lat, frames, sizeof(bench_lat[0]), cmp_u32);
+
+		shell_print(sh, "%s: %llu.%02llu fps, %llu B/s, CPU %u.%u%%", bench_names[kind],
+			    fps / 100U, fps % 100U,
+			    (after.bytes_sent - before.bytes_sent) * USEC_PER_SEC / total_us,
+			    load / 10U, load % 10U);
+		shell_print(sh, "%s: latency avg %llu us, p99 %u us", bench_names[kind],
+			    lat_sum / frames, bench_lat[DIV_ROUND_UP(frames * 99U, 100U) - 1U]);
+	}
+
+	timing_stop();
+
+	if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+	}
+
+	return 0;
+}
+
+static int cmd_display_dash_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t period = DASH_PERIOD_MS;
+	bool running = dash_is_running();
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (display_held()) {
+		shell_error(sh, "Display in hold mode");
+		return -EPERM;
+	}
+
+	if (gray_is_running()) {
+		shell_error(sh, "Stop grayscale mode first");
+		return -EBUSY;
+	}
+
+	if (argc > 1) {
+		period = strtoul(argv[1], NULL, 0);
+	}
+
+	err = dash_start(period);
+	if (err < 0) {
+		shell_error(sh, "Invalid period (%u-%u ms)", DASH_PERIOD_MS_MIN, DASH_PERIOD_MS_MAX);
+		return err;
+	}
+
+	if (running) {
+		shell_print(sh, "Dashboard period set to %u ms", period);
+	} else {
+		shell_print(sh, "Dashboard started, refreshing every %u ms", period);
+	}
+
+	return 0;
+}
+
+static int cmd_display_dash_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (dash_stop() < 0) {
+		shell_error(sh, "Dashboard not running");
+		return -EPERM;
+	}
+
+	shell_print(sh, "Dashboard stopped");
+
+	return 0;
+}
+
+static int cmd_display_dash_cost(const struct shell *sh, size_t argc, char **argv)
+{
+	struct ls013b7dh05_stats before, after;
+	struct compositor_stats comp_before, comp_after;
+	struct dash_stats start, end;
+	uint32_t refreshes = 5U;
+	uint32_t n, load;
+
+	if (!dash_is_running()) {
+		shell_error(sh, "Dashboard not running");
+		return -EPERM;
+	}
+
+	if (argc > 1) {
+		refreshes = strtoul(argv[1], NULL, 0);
+		if (refreshes == 0U) {
+			shell_error(sh, "Invalid number of refreshes");
+			return -EINVAL;
+		}
+	}
+
+	dash_get_stats(&start);
+	ls013b7dh05_get_stats(disp, &before);
+	compositor_get_stats(&comp_before);
+	cpuload_start();
+
+	k_sleep(K_MSEC(refreshes * dash_get_period()));
+
+	load = cpuload_stop();
+	compositor_get_stats(&comp_after);
+	ls013b7dh05_get_stats(disp, &after);
+	dash_get_stats(&end);
+
+	n = end.refreshes - start.refreshes;
+	if (n == 0U) {
+		shell_error(sh, "No refresh happened");
+		return 0;
+	}
+
+	shell_print(sh, "%u refreshes, %u cells, %u flushes", n, end.cells - start.cells,
+		    comp_after.flushes - comp_before.flushes);
+	shell_print(sh, "Per refresh: %llu SPI bytes, %u lines",
+		    (after.bytes_sent - before.bytes_sent) / n,
+		    (after.lines_sent - before.lines_sent) / n);
+	shell_print(sh, "Per refresh: sample %llu us, render %llu us, flush %llu us",
+		    (end.sample_us - start.sample_us) / n, (end.render_us - start.render_us) / n,
+		    (comp_after.flush_us - comp_before.flush_us) / n);
+	shell_print(sh, "CPU %u.%u%%", load / 10U, load % 10U);
+
+	return 0;
+}
+
+static void display_stream_stop(const struct shell *sh)
+{
+	struct stream_stats stats;
+	uint32_t elapsed, fps;
+	int err;
+
+	shell_set_bypass(sh, NULL);
+
+	err = stream_stop(&stats);
+
+	elapsed = MAX(stats.elapsed_ms, 1U);
+	fps = (uint64_t)stats.shown * MSEC_PER_SEC * 100U / elapsed;
+
+	shell_print(sh, "Frames: %u, shown: %u, dropped: %u", stats.frames, stats.shown,
+		    stats.dropped);
+	shell_print(sh, "%u.%02u fps, %llu B/s", fps / 100U, fps % 100U,
+		    (uint64_t)stats.bytes * MSEC_PER_SEC / elapsed);
+
+	if (err < 0) {
+		shell_error(sh, "Stream failed (%d)", err);
+	} else if (stats.errors > 0U) {
+		shell_error(sh, "%u failed writes", stats.errors);
+	}
+}
+
+/* once the stream ended or failed, hand the link back to the shell */
+static void stream_bypass(const struct shell *sh, uint8_t *data, size_t len)
+{
+	if (stream_feed(data, len)) {
+		display_stream_stop(sh);
+	}
+}
+
+static int cmd_display_stream(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	err = stream_start();
+	if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+		return 0;
+	}
+
+	shell_print(sh, "Streaming, send frames");
+
+	shell_set_bypass(sh, stream_bypass);
+
+	return 0;
+}
+
+static int cmd_display_play_list(const struct shell *sh)
+{
+	char name[ASSET_NAME_LEN];
+	size_t idx;
+	int err;
+
+	for (idx = 0U;; idx++) {
+		err = asset_get_name(idx, name);
+		if (err < 0) {
+			break;
+		}
+
+		shell_print(sh, "%s", name);
+	}
+
+	if (err != -ENOENT) {
+		shell_error(sh, "Failed to read assets (%d)", err);
+	} else if (idx == 0U) {
+		shell_print(sh, "No assets");
+	}
+
+	return 0;
+}
+
+static int cmd_display_play(const struct shell *sh, size_t argc, char **argv)
+{
+	struct play_stats stats;
+	uint32_t loops = 1U;
+	uint32_t fps;
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (argc < 2) {
+		return cmd_display_play_list(sh);
+	}
+
+	if (argc > 2) {
+		loops = strtoul(argv[2], NULL, 0);
+		if (loops == 0U || loops > PLAY_LOOPS_MAX) {
+			shell_error(sh, "Invalid number of loops (1-%u)", PLAY_LOOPS_MAX);
+			return -EINVAL;
+		}
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	err = play_asset(argv[1], loops, &stats);
+	if (err == -ENOENT) {
+		shell_error(sh, "Asset not found");
+		return err;
+	} else if (err == -ENODATA) {
+		shell_error(sh, "Asset has no frames");
+		return -EINVAL;
+	} else if (err == -EMSGSIZE) {
+		shell_error(sh, "Asset is not %ux%u", DISP_WIDTH, DISP_HEIGHT);
+		return -EINVAL;
+	} else if (err == -ENOTSUP) {
+		shell_error(sh, "Playback needs the normal orientation");
+		return -EINVAL;
+	} else if (err < 0) {
+		shell_error(sh, "Playback failed (%d)", err);
+		return 0;
+	}
+
+	fps = (uint64_t)stats.frames * MSEC_PER_SEC * 100U / MAX(stats.elapsed_ms, 1U);
+
+	shell_print(sh, "%u frames, %u.%02u fps", stats.frames, fps / 100U, fps % 100U);
+	shell_print(sh, "Per frame: %u flash bytes, %u lines decoded, %llu SPI bytes",
+		    stats.flash_bytes / stats.frames, stats.lines / stats.frames,
+		    stats.spi_bytes / stats.frames);
+	shell_print(sh, "Per frame: decode %llu us, write %llu us", stats.decode_us / stats.frames,
+		    stats.write_us / stats.frames);
+
+	return 0;
+}
+
+static int cmd_display_orientation(const struct shell *sh, size_t argc, char **argv)
+{
+	struct display_capabilities caps;
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (argc > 1) {
+		uint32_t deg = strtoul(argv[1], NULL, 0);
+
+		if (deg % 90U != 0U || deg > 270U) {
+			shell_error(sh, "Invalid orientation (0, 90, 180 or 270)");
+			return -EINVAL;
+		}
+
+		err = display_set_orientation(disp, deg / 90U);
+		if (err < 0) {
+			shell_error(sh, "Failed to set orientation (%d)", err);
+			return 0;
+		}
+	}
+
+	display_get_capabilities(disp, &caps);
+
+	shell_print(sh, "Orientation: %u degrees, %ux%u", caps.current_orientation * 90U,
+		    caps.x_resolution, caps.y_resolution);
+
+	return 0;
+}
+
+/*
+ * Per-pixel reference rotation, checked against the output of the driver,
+ * which transposes 8x8 pixel blocks instead.
+ */
+static void rotate_naive(const struct raster *src, enum display_orientation orientation)
+{
+	memset(rotate_buf, 0, sizeof(rotate_buf));
+
+	for (uint16_t y = 0U; y < src->height; y++) {
+		for (uint16_t x = 0U; x < src->width; x++) {
+			uint8_t bit = (src->buf[y * src->pitch + x / 8U] >> (x % 8U)) & 1U;
+			uint16_t px, py;
+
+			switch (orientation) {
+			case DISPLAY_ORIENTATION_ROTATED_90:
+				px = DISP_WIDTH - 1U - y;
+				py = x;
+				break;
+			case DISPLAY_ORIENTATION_ROTATED_180:
+				px = DISP_WIDTH - 1U - x;
+				py = DISP_HEIGHT - 1U - y;
+				break;
+			case DISPLAY_ORIENTATION_ROTATED_270:
+				px = y;
+				py = DISP_HEIGHT - 1U - x;
+				break;
+			default:
+				px = x;
+				py = y;
+				break;
+			}
+
+			rotate_buf[py][px / 8U] |= bit << (px % 8U);
+		}
+	}
+}
+
+static int cmd_display_rotbench(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frames = 20U;
+	int err = 0;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U || frames > ROTATE_FRAMES_MAX) {
+			shell_error(sh, "Invalid number of frames (1-%u)", ROTATE_FRAMES_MAX);
+			return -EINVAL;
+		}
+	}
+
+	timing_init();
+	timing_start();
+
+	/*
+	 * The same frame is written over and over, so that after the first
+	 * write no line is sent and only the rotation and the line signatures
+	 * are measured.
+	 */
+	for (enum display_orientation o = DISPLAY_ORIENTATION_ROTATED_90;
+	     o <= DISPLAY_ORIENTATION_ROTATED_270; o++) {
+		bool swapped = (o != DISPLAY_ORIENTATION_ROTATED_180);
+		const struct raster src = {
+			.buf = &bench_buf[0][0],
+			.width = swapped ? DISP_HEIGHT : DISP_WIDTH,
+			.height = swapped ? DISP_WIDTH : DISP_HEIGHT,
+			.pitch = swapped ? DISP_HEIGHT / 8U : DISP_WIDTH / 8U,
+		};
+		const struct display_buffer_descriptor src_desc = {
+			.width = src.width,
+			.height = src.height,
+			.pitch = src.width,
+		};
+		struct ls013b7dh05_stats before, after;
+		timing_t start, end;
+		uint64_t fast_us, naive_us;
+
+		(void)pattern_render("address", &src);
+
+		err = display_set_orientation(disp, o);
+		if (err < 0) {
+			break;
+		}
+
+		err = display_write(disp, 0, 0, &src_desc, src.buf);
+		if (err < 0) {
+			break;
+		}
+
+		start = timing_counter_get();
+		for (uint32_t i = 0U; i < frames && err == 0; i++) {
+			err = display_write(disp, 0, 0, &src_desc, src.buf);
+		}
+		end = timing_counter_get();
+
+		fast_us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+		err = display_set_orientation(disp, DISPLAY_ORIENTATION_NORMAL);
+		if (err < 0) {
+			break;
+		}
+
+		/* a frame rotated the same way as the driver did sends no line */
+		ls013b7dh05_get_stats(disp, &before);
+
+		start = timing_counter_get();
+		for (uint32_t i = 0U; i < frames && err == 0; i++) {
+			rotate_naive(&src, o);
+			err = display_write(disp, 0, 0, &desc, rotate_buf);
+		}
+		end = timing_counter_get();
+
+		ls013b7dh05_get_stats(disp, &after);
+
+		if (err < 0) {
+			break;
+		}
+
+		naive_us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+		shell_print(sh, "%u: transpose %llu us/frame, naive %llu us/frame%s", o * 90U,
+			    fast_us / frames, naive_us / frames,
+			    (after.lines_sent != before.lines_sent) ? " (MISMATCH)" : "");
+	}
+
+	timing_stop();
+
+	(void)display_set_orientation(disp, DISPLAY_ORIENTATION_NORMAL);
+
+	if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+	}
+
+	return 0;
+}
+
+/* synthetic grayscale images, generated one row at a time */
+static int dither_source(const char *name, uint16_t y, uint8_t *row)
+{
+	if (strcmp(name, "hramp") == 0) {
+		for (uint16_t x = 0U; x < DISP_WIDTH; x++) {
+			row[x] = x * 255U / (DISP_WIDTH - 1U);
+		}
+	} else if (strcmp(name, "vramp") == 0) {
+		memset(row, y * 255U / (DISP_HEIGHT - 1U), DISP_WIDTH);
+	} else if (strcmp(name, "radial") == 0) {
+		/* white in the center, black in the corners */
+		int32_t cx = DISP_WIDTH / 2;
+		int32_t cy = DISP_HEIGHT / 2;
+		int32_t max = cx * cx + cy * cy;
+		int32_t dy = y - cy;
+
+		for (uint16_t x = 0U; x < DISP_WIDTH; x++) {
+			int32_t dx = x - cx;
+
+			row[x] = 255 - (dx * dx + dy * dy) * 255 / max;
+		}
+	} else {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+static int cmd_display_dither(const struct shell *sh, size_t argc, char **argv)
+{
+	static struct dither dither;
+	const char *source = (argc > 2) ? argv[2] : "hramp";
+	enum dither_method method;
+	uint8_t row[DISP_WIDTH];
+	uint64_t cycles = 0U;
+	uint64_t ns, pps;
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	err = display_busy(sh);
+	if (err < 0) {
+		return err;
+	}
+
+	if (strcmp(argv[1], "bayer") == 0) {
+		method = DITHER_BAYER;
+	} else if (strcmp(argv[1], "fs") == 0) {
+		method = DITHER_FLOYD_STEINBERG;
+	} else {
+		shell_error(sh, "Invalid method (bayer, fs)");
+		return -EINVAL;
+	}
+
+	if (dither_source(source, 0U, row) < 0) {
+		shell_error(sh, "Invalid source (hramp, vramp, radial)");
+		return -EINVAL;
+	}
+
+	timing_init();
+	timing_start();
+
+	/* rows go straight to the framebuffer, the image is never held in grayscale */
+	dither_init(&dither, method, DISP_WIDTH);
+
+	for (uint16_t y = 0U; y < DISP_HEIGHT; y++) {
+		timing_t start, end;
+
+		(void)dither_source(source, y, row);
+
+		start = timing_counter_get();
+		dither_row(&dither, row, ls013b7dh05_get_line(disp, y));
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	timing_stop();
+
+	err = display_write(disp, 0, 0, &desc, display_get_framebuffer(disp));
+	if (err < 0) {
+		shell_error(sh, "Failed to write to display (%d)", err);
+		return 0;
+	}
+
+	ns = MAX(timing_cycles_to_ns(cycles), 1U);
+	pps = (uint64_t)DISP_WIDTH * DISP_HEIGHT * NSEC_PER_SEC / ns;
+
+	shell_print(sh, "%s: %llu us per frame, %llu pixels/s", argv[1], ns / NSEC_PER_USEC, pps);
+
+	return 0;
+}
+
+static void gray_row(uint16_t y, uint8_t *row)
+{
+	(void)dither_source(gray_source, y, row);
+}
+
+static int cmd_display_gray_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint8_t row[DISP_WIDTH];
+	uint32_t levels = GRAY_LEVELS_MAX;
+	uint32_t hz = GRAY_HZ;
+	int err;
+
+	if (!initialized) {
+		shell_error(sh, "Display module not initialized");
+		return -EPERM;
+	}
+
+	if (display_held()) {
+		shell_error(sh, "Display in hold mode");
+		return -EPERM;
+	}
+
+	if (dash_is_running()) {
+		shell_error(sh, "Dashboard running");
+		return -EBUSY;
+	}
+
+	if (argc > 1) {
+		levels = strtoul(argv[1], NULL, 0);
+	}
+
+	if (argc > 2) {
+		hz = strtoul(argv[2], NULL, 0);
+	}
+
+	gray_source = (argc > 3) ? argv[3] : "hramp";
+	if (dither_source(gray_source, 0U, row) < 0) {
+		shell_error(sh, "Invalid source (hramp, vramp, radial)");
+		return -EINVAL;
+	}
+
+	err = gray_start(levels, hz, gray_row);
+	if (err == -EINVAL) {
+		shell_error(sh, "Invalid levels (2-%u) or rate (1-%u Hz)", GRAY_LEVELS_MAX,
+			    GRAY_HZ_MAX);
+		return err;
+	} else if (err == -EBUSY) {
+		shell_error(sh, "Grayscale mode already running");
+		return err;
+	} else if (err < 0) {
+		shell_error(sh, "Failed to start grayscale mode (%d)", err);
+		return 0;
+	}
+
+	shell_print(sh, "Showing %s with %u levels, %u phases at %u Hz", gray_source, levels,
+		    levels - 1U, hz);
+
+	return 0;
+}
+
+static int cmd_display_gray_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	struct gray_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (gray_stop() < 0) {
+		shell_error(sh, "Grayscale mode not running");
+		return -EPERM;
+	}
+
+	gray_get_stats(&stats);
+
+	shell_print(sh, "Phases: %u (%u late), errors: %u", stats.phases, stats.late,
+		    stats.errors);
+	shell_print(sh, "Lines: %u (%u per phase)", stats.lines,
+		    stats.lines / MAX(stats.phases, 1U));
+	shell_print(sh, "Write: %llu us avg, %u us max", stats.write_us / MAX(stats.phases, 1U),
+		    stats.max_write_us);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_dash_cmds,
+	SHELL_CMD_ARG(start, NULL, "Start dashboard: start [PERIOD_MS]", cmd_display_dash_start, 1,
+		      1),
+	SHELL_CMD(stop, NULL, "Stop dashboard", cmd_display_dash_stop),
+	SHELL_CMD_ARG(cost, NULL, "Measure refresh cost: cost [REFRESHES]", cmd_display_dash_cost,
+		      1, 1),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_gray_cmds,
+	SHELL_CMD_ARG(start, NULL, "Start grayscale mode: start [LEVELS [HZ [hramp|vramp|radial]]]",
+		      cmd_display_gray_start, 1, 3),
+	SHELL_CMD(stop, NULL, "Stop grayscale mode, show statistics", cmd_display_gray_stop),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_display_cmds, SHELL_CMD(on, NULL, "Turn on display", cmd_display_on),
+	SHELL_CMD(off, NULL, "Turn off display", cmd_display_off),
+	SHELL_CMD_ARG(hold, NULL, "Keep the image at minimum power: hold on|off", cmd_display_hold,
+		      2, 0),
+	SHELL_CMD(clear, NULL, "Clear display", cmd_display_clear),
+	SHELL_CMD(vpattern, NULL, "Display vertical pattern", cmd_display_vpattern),
+	SHELL_CMD(hpattern, NULL, "Display horizontal pattern", cmd_display_hpattern),
+	SHELL_CMD_ARG(pattern, &dsub_pattern_name, "Display test pattern: pattern NAME",
+		      cmd_display_pattern, 2, 0),
+	SHELL_CMD_ARG(fps, NULL, "Show compositor statistics, set max frame rate: fps [FPS]",
+		      cmd_display_fps, 1, 1),
+	SHELL_CMD_ARG(brightness, NULL, "Set display brightness", cmd_display_brightness, 2, 0),
+	SHELL_CMD_ARG(stats, NULL, "Show transfer statistics: stats [reset]", cmd_display_stats, 1,
+		      1),
+	SHELL_CMD_ARG(anim, NULL, "Run scrolling animation: anim [FRAMES]", cmd_display_anim, 1, 1),
+	SHELL_CMD_ARG(scroll, NULL, "Scroll up one line per frame: scroll [FRAMES]",
+		      cmd_display_scroll, 1, 1),
+	SHELL_CMD_ARG(cpu, NULL, "Compare blocking and async CPU time: cpu [FRAMES]",
+		      cmd_display_cpu, 1, 1),
+	SHELL_CMD_ARG(bench, NULL, "Benchmark display throughput: bench [FRAMES]",
+		      cmd_display_bench, 1, 1),
+	SHELL_CMD(dash, &sub_dash_cmds, "Sensor dashboard", NULL),
+	SHELL_CMD(stream, NULL, "Show frames streamed from the host", cmd_display_stream),
+	SHELL_CMD_ARG(dither, NULL, "Dither grayscale image: dither bayer|fs [hramp|vramp|radial]",
+		      cmd_display_dither, 2, 1),
+	SHELL_CMD(gray, &sub_gray_cmds, "Temporal dither grayscale mode", NULL),
+	SHELL_CMD_ARG(orientation, NULL, "Show or set orientation: orientation [0|90|180|270]",
+		      cmd_display_orientation, 1, 1),
+	SHELL_CMD_ARG(rotbench, NULL, "Compare transpose and naive rotation: rotbench [FRAMES]",
+		      cmd_display_rotbench, 1, 1),
+	SHELL_CMD_ARG(play, NULL, "Play asset from flash, list assets: play [NAME [LOOPS]]",
+		      cmd_display_play, 1, 2),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((hwv), display, &sub_display_cmds, "Display", NULL, 0, 0);
+
+int display_init(void)
+{
+	int ret;
+
+	if (!device_is_ready(disp)) {
+		return -ENODEV;
+	}
+
+	font_init();
+
+	ret = compositor_init(disp);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = dash_init();
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = gray_init(disp);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = play_init(disp);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = stream_init(disp);
+	if (ret < 0) {
+		return ret;
 	}
 
 	initialized = true;
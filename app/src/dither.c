@@ -0,0 +1,88 @@
+#include "dither.h"
+
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+/* 8x8 ordered dither thresholds */
+static const uint8_t bayer8[8][8] = {
+	{0U, 32U, 8U, 40U, 2U, 34U, 10U, 42U},
+	{48U, 16U, 56U, 24U, 50U, 18U, 58U, 26U},
+	{12U, 44U, 4U, 36U, 14U, 46U, 6U, 38U},
+	{60U, 28U, 52U, 20U, 62U, 30U, 54U, 22U},
+	{3U, 35U, 11U, 43U, 1U, 33U, 9U, 41U},
+	{51U, 19U, 59U, 27U, 49U, 17U, 57U, 25U},
+	{15U, 47U, 7U, 39U, 13U, 45U, 5U, 37U},
+	{63U, 31U, 55U, 23U, 61U, 29U, 53U, 21U},
+};
+
+void dither_init(struct dither *d, enum dither_method method, uint16_t width)
+{
+	d->method = method;
+	d->width = MIN(width, DITHER_WIDTH_MAX);
+	d->y = 0U;
+
+	memset(d->err, 0, sizeof(d->err));
+}
+
+static void dither_bayer(struct dither *d, const uint8_t *gray, uint8_t *line)
+{
+	uint8_t thr[8];
+
+	/* thresholds centered in their 1/64 step, over 0-255 */
+	for (uint8_t i = 0U; i < ARRAY_SIZE(thr); i++) {
+		thr[i] = bayer8[d->y % 8U][i] * 4U + 2U;
+	}
+
+	for (uint16_t x = 0U; x < d->width; x += 8U) {
+		uint8_t n = MIN(8U, d->width - x);
+		uint8_t byte = 0U;
+
+		for (uint8_t i = 0U; i < n; i++) {
+			byte |= (gray[x + i] > thr[i]) << i;
+		}
+
+		line[x / 8U] = byte;
+	}
+}
+
+static void dither_fs(struct dither *d, const uint8_t *gray, uint8_t *line)
+{
+	/* both rows have a guard entry on each side, so that edges need no test */
+	int16_t *cur = &d->err[d->y % 2U][1];
+	int16_t *next = &d->err[(d->y + 1U) % 2U][1];
+
+	memset(next - 1, 0, (d->width + 2U) * sizeof(*next));
+
+	for (uint16_t x = 0U; x < d->width; x++) {
+		int16_t val = gray[x] + ((cur[x] + 8) >> 4);
+		int16_t err;
+
+		if (x % 8U == 0U) {
+			line[x / 8U] = 0U;
+		}
+
+		if (val >= 128) {
+			line[x / 8U] |= BIT(x % 8U);
+			err = val - 255;
+		} else {
+			err = val;
+		}
+
+		cur[x + 1] += err * 7;
+		next[x - 1] += err * 3;
+		next[x] += err * 5;
+		next[x + 1] += err;
+	}
+}
+
+void dither_row(struct dither *d, const uint8_t *gray, uint8_t *line)
+{
+	if (d->method == DITHER_BAYER) {
+		dither_bayer(d, gray, line);
+	} else {
+		dither_fs(d, gray, line);
+	}
+
+	d->y++;
+}
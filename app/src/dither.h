@@ -0,0 +1,48 @@
+#ifndef APP_SRC_DITHER_H_
+#define APP_SRC_DITHER_H_
+
+#include <stdint.h>
+
+/** Maximum row width, in pixels. */
+#define DITHER_WIDTH_MAX 256U
+
+/** @brief Dithering methods. */
+enum dither_method {
+	/** 8x8 ordered dither, fast. */
+	DITHER_BAYER,
+	/** Floyd-Steinberg error diffusion, better quality. */
+	DITHER_FLOYD_STEINBERG,
+};
+
+/**
+ * @brief Dithering state.
+ *
+ * Rows are dithered one at a time, top to bottom. Error diffusion keeps the
+ * errors of the current and next rows only, in 1/16 units.
+ */
+struct dither {
+	enum dither_method method;
+	uint16_t width;
+	uint16_t y;
+	int16_t err[2][DITHER_WIDTH_MAX + 2U];
+};
+
+/**
+ * @brief Start dithering an image.
+ *
+ * @param d Dithering state.
+ * @param method Dithering method.
+ * @param width Row width, at most DITHER_WIDTH_MAX.
+ */
+void dither_init(struct dither *d, enum dither_method method, uint16_t width);
+
+/**
+ * @brief Dither the next row.
+ *
+ * @param d Dithering state.
+ * @param gray Grayscale row, 8 bits per pixel, 0 being black.
+ * @param line Output line, in the display format (PIXEL_FORMAT_MONO01).
+ */
+void dither_row(struct dither *d, const uint8_t *gray, uint8_t *line);
+
+#endif /* APP_SRC_DITHER_H_ */
@@ -1,14 +1,177 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include <zephyr/drivers/flash.h>
 #include <zephyr/drivers/regulator.h>
 #include <zephyr/kernel.h>
 #include <zephyr/pm/device.h>
 #include <zephyr/shell/shell.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/timing/timing.h>
+
+/* dump frame: magic, sequence number, length, address, data, CRC32 */
+#define DUMP_MAGIC     "HWVD"
+#define DUMP_MAGIC_LEN 4U
+#define DUMP_HDR_LEN   8U
+#define DUMP_CHUNK     2048U
+
+/* load chunk: sequence number, length, data, CRC32 */
+#define LOAD_HDR_LEN 4U
+#define LOAD_CHUNK   1024U
+#define LOAD_PAGE    256U
+/* a chunk interrupted for that long is dropped, the host sends it again */
+#define LOAD_GAP_MS  100U
+/* without traffic for that long, the host is gone and the load ends */
+#define LOAD_IDLE_MS 5000U
+
+#define FLASH_STACK_SIZE 1024
+/* above the shell, which keeps receiving while the flash is busy */
+#define FLASH_PRIO       K_PRIO_PREEMPT(10)
+
+/* benchmarks only run in the scratch partition, whose contents are lost */
+#define BENCH_PARTITION    FIXED_PARTITION_ID(scratch_partition)
+#define BENCH_CHIP_SIZE    (DT_PROP(DT_ALIAS(flash0), size) / 8U)
+#define BENCH_BUF_SIZE     4096U
+#define BENCH_READ_TOTAL   KB(256)
+#define BENCH_RANDOM_READS 256U
+#define BENCH_PAGE         256U
+#define BENCH_PROGRAM_SIZE KB(64)
+
+#define VERIFY_CHUNK   KB(4)
+#define VERIFY_PAGE    256U
+#define VERIFY_BAD_MAX 8U
+#define VERIFY_BLANK   UINT32_MAX
+
+enum verify_pattern {
+	VERIFY_ADDR,
+	VERIFY_CHECKER,
+	VERIFY_ZEROS,
+};
+
+/* chunk read back, waiting to be compared */
+struct verify_chunk {
+	uint32_t addr;
+	bool blank;
+};
+
+/* range erased, programmed and read back by the flash work queue */
+struct verify_range {
+	uint32_t addr;
+	uint32_t size;
+	int ret;
+};
+
+struct verify_stats {
+	uint32_t bad_words;
+	/* bits that read 0 instead of 1, and 1 instead of 0 */
+	uint32_t bits_to_0;
+	uint32_t bits_to_1;
+	uint32_t bad_blocks;
+	uint32_t last_bad_block;
+	uint32_t bad_addr[VERIFY_BAD_MAX];
+	uint32_t bad_expected[VERIFY_BAD_MAX];
+	uint32_t bad_read[VERIFY_BAD_MAX];
+	uint32_t bad_block[VERIFY_BAD_MAX];
+};
+
+enum load_state {
+	LOAD_HEADER,
+	LOAD_DATA,
+	LOAD_CRC,
+};
+
+struct load {
+	enum load_state state;
+	uint8_t hdr[LOAD_HDR_LEN];
+	uint8_t crc[4];
+	uint8_t *dst;
+	size_t left;
+	/* buffer being received, and buffer to program next */
+	uint8_t rx;
+	uint8_t prog;
+	bool drop;
+	bool done;
+	uint16_t seq;
+	/* number of chunks programmed, written by the flash work queue only */
+	uint16_t acked;
+	uint16_t len[2];
+	uint16_t chunk_seq[2];
+	uint32_t addr;
+	uint32_t size;
+	uint32_t received;
+	uint32_t programmed;
+	uint32_t erased;
+	uint32_t naks;
+	uint32_t erase_ms;
+	uint32_t prog_ms;
+	int64_t start;
+	int64_t last_rx;
+	int err;
+};
+
+struct bench_result {
+	uint32_t count;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+struct bench_erase {
+	const char *name;
+	uint32_t size;
+	uint32_t count;
+};
+
+struct dump_read {
+	uint32_t addr;
+	size_t len;
+	uint8_t idx;
+	int ret;
+};
 
 static const struct device *const flash = DEVICE_DT_GET(DT_ALIAS(flash0));
 static bool initialized;
 
+static K_THREAD_STACK_DEFINE(flash_stack, FLASH_STACK_SIZE);
+static struct k_work_q flash_wq;
+
+static uint8_t dump_buf[2][DUMP_CHUNK];
+static struct dump_read dump_read;
+static struct k_work dump_work;
+static K_SEM_DEFINE(dump_done, 0, 1);
+
+static uint8_t load_buf[2][LOAD_CHUNK] __aligned(4);
+static uint8_t bench_buf[BENCH_BUF_SIZE] __aligned(4);
+
+static uint8_t verify_buf[2][VERIFY_CHUNK] __aligned(4);
+static uint8_t verify_page[VERIFY_PAGE] __aligned(4);
+static struct verify_chunk verify_chunks[2];
+static struct verify_range verify_range;
+static enum verify_pattern verify_pattern;
+static struct verify_stats verify_stats;
+static atomic_t verify_ready;
+static uint8_t verify_check;
+static struct k_work verify_work;
+static K_SEM_DEFINE(verify_free, 2, 2);
+/* given for each chunk read back, and once more when the range is done */
+static K_SEM_DEFINE(verify_filled, 0, 3);
+
+static const uint32_t bench_read_sizes[] = {16U, 256U, 4096U};
+static const struct bench_erase bench_erases[] = {
+	{"erase4k", KB(4), 16U},
+	{"erase32k", KB(32), 4U},
+	{"erase64k", KB(64), 4U},
+};
+static struct load load;
+static const struct shell *load_sh;
+static atomic_t load_ready;
+static atomic_t load_active;
+static struct k_work load_work;
+static struct k_work_delayable load_timeout;
+
 static int cmd_flash_id(const struct shell *sh, size_t argc, char **argv)
 {
 	int ret;
@@ -133,6 +296,169 @@ end:
 	return ret;
 }
 
+static void dump_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	dump_read.ret = flash_read(flash, dump_read.addr, dump_buf[dump_read.idx], dump_read.len);
+
+	k_sem_give(&dump_done);
+}
+
+static void dump_start(uint32_t addr, size_t len, uint8_t idx)
+{
+	dump_read.addr = addr;
+	dump_read.len = len;
+	dump_read.idx = idx;
+
+	(void)k_work_submit(&dump_work);
+}
+
+/*
+ * Frames go straight to the shell transport, whichever it is: shell_fprintf()
+ * would expand line feeds in the binary data.
+ */
+static int dump_send(const struct shell *sh, const void *data, size_t len)
+{
+	const uint8_t *buf = data;
+	size_t cnt;
+	int ret;
+
+	while (len > 0U) {
+		ret = sh->iface->api->write(sh->iface, buf, len, &cnt);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* the transport buffer is full, let it drain */
+		if (cnt == 0U) {
+			k_yield();
+		}
+
+		buf += cnt;
+		len -= cnt;
+	}
+
+	return 0;
+}
+
+static int dump_frame(const struct shell *sh, uint16_t seq, uint32_t addr, const uint8_t *buf,
+		      size_t len)
+{
+	uint8_t hdr[DUMP_HDR_LEN];
+	uint8_t crc[4];
+	int ret;
+
+	sys_put_le16(seq, &hdr[0]);
+	sys_put_le16(len, &hdr[2]);
+	sys_put_le32(addr, &hdr[4]);
+
+	sys_put_le32(crc32_ieee_update(crc32_ieee(hdr, sizeof(hdr)), buf, len), crc);
+
+	ret = dump_send(sh, DUMP_MAGIC, DUMP_MAGIC_LEN);
+	if (ret == 0) {
+		ret = dump_send(sh, hdr, sizeof(hdr));
+	}
+
+	if (ret == 0) {
+		ret = dump_send(sh, buf, len);
+	}
+
+	if (ret == 0) {
+		ret = dump_send(sh, crc, sizeof(crc));
+	}
+
+	return ret;
+}
+
+/*
+ * Binary bulk read for scripts/flashdump.py. Frames are sent from one buffer
+ * while the next chunk is read into the other one, and an empty frame ends
+ * the dump.
+ */
+static int cmd_flash_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t addr, end;
+	uint32_t len, left;
+	uint16_t seq = 0U;
+	int64_t start;
+	uint32_t ms;
+	int ret, err = 0;
+
+	if (!initialized) {
+		shell_error(sh, "Flash module not initialized");
+		return -EPERM;
+	}
+
+	addr = strtoul(argv[1], NULL, 0);
+	len = strtoul(argv[2], NULL, 0);
+
+	ret = pm_device_action_run(flash, PM_DEVICE_ACTION_RESUME);
+	if (ret < 0) {
+		shell_error(sh, "Failed to resume flash (%d)", ret);
+		return ret;
+	}
+
+	start = k_uptime_get();
+
+	end = addr;
+	left = len;
+	if (left > 0U) {
+		dump_start(end, MIN(left, DUMP_CHUNK), 0U);
+	}
+
+	while (left > 0U) {
+		struct dump_read cur;
+
+		(void)k_sem_take(&dump_done, K_FOREVER);
+
+		cur = dump_read;
+		if (cur.ret < 0) {
+			ret = cur.ret;
+			break;
+		}
+
+		end += cur.len;
+		left -= cur.len;
+
+		if (left > 0U) {
+			dump_start(end, MIN(left, DUMP_CHUNK), cur.idx ^ 1U);
+		}
+
+		err = dump_frame(sh, seq++, cur.addr, dump_buf[cur.idx], cur.len);
+		if (err < 0) {
+			/* the flash stays up until the next chunk is read */
+			if (left > 0U) {
+				(void)k_sem_take(&dump_done, K_FOREVER);
+			}
+			break;
+		}
+	}
+
+	if (ret == 0 && err == 0) {
+		err = dump_frame(sh, seq, end, NULL, 0U);
+	}
+
+	ms = MAX(k_uptime_get() - start, 1);
+
+	(void)pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
+
+	if (ret < 0) {
+		shell_error(sh, "Failed to read from flash at 0x%08x (%d)", end, ret);
+		return ret;
+	}
+
+	if (err < 0) {
+		shell_error(sh, "Failed to send frame (%d)", err);
+		return err;
+	}
+
+	shell_print(sh, "Dumped %u bytes in %u frames, %u ms, %llu B/s", len, seq, ms,
+		    (uint64_t)len * MSEC_PER_SEC / ms);
+
+	return 0;
+}
+
 static int cmd_flash_write(const struct shell *sh, size_t argc, char **argv)
 {
 	int ret;
@@ -184,10 +510,803 @@ static int cmd_flash_write(const struct shell *sh, size_t argc, char **argv)
 	return ret;
 }
 
+/* erase whole sectors ahead of the data, 64 KB blocks when possible */
+static int load_erase(uint32_t end)
+{
+	struct flash_pages_info info;
+	int64_t start = k_uptime_get();
+	int ret;
+
+	while (load.erased < end) {
+		uint32_t size;
+
+		ret = flash_get_page_info_by_offs(flash, load.erased, &info);
+		if (ret < 0) {
+			return ret;
+		}
+
+		size = info.size;
+		if (load.erased % KB(64) == 0U && load.addr + load.size - load.erased >= KB(64)) {
+			size = KB(64);
+		}
+
+		ret = flash_erase(flash, load.erased, size);
+		if (ret < 0) {
+			return ret;
+		}
+
+		load.erased += size;
+	}
+
+	load.erase_ms += k_uptime_get() - start;
+
+	return 0;
+}
+
+static void load_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	while (atomic_test_bit(&load_ready, load.prog)) {
+		uint8_t idx = load.prog;
+		uint16_t seq = load.chunk_seq[idx];
+		uint32_t addr = load.addr + seq * LOAD_CHUNK;
+		uint16_t len = load.len[idx];
+		int64_t start;
+		int ret;
+
+		ret = load_erase(addr + len);
+
+		start = k_uptime_get();
+		for (uint16_t off = 0U; ret == 0 && off < len; off += LOAD_PAGE) {
+			ret = flash_write(flash, addr + off, &load_buf[idx][off],
+					  MIN(LOAD_PAGE, len - off));
+		}
+		load.prog_ms += k_uptime_get() - start;
+
+		/* release the buffer first, the host sends the next chunk on ACK */
+		load.prog ^= 1U;
+		atomic_clear_bit(&load_ready, idx);
+
+		if (ret < 0) {
+			load.err = ret;
+			shell_print(load_sh, "NAK %u %d", seq, ret);
+		} else {
+			load.programmed += len;
+			load.acked = seq + 1U;
+			shell_print(load_sh, "ACK %u", seq);
+		}
+	}
+}
+
+static void load_stop(const struct shell *sh)
+{
+	uint32_t ms;
+
+	/* the bypass callback and the timeout may both end the load */
+	if (!atomic_cas(&load_active, 1, 0)) {
+		return;
+	}
+
+	shell_set_bypass(sh, NULL);
+	(void)k_work_cancel_delayable(&load_timeout);
+
+	/* the last chunk is being programmed */
+	while (atomic_get(&load_ready) != 0) {
+		k_sleep(K_MSEC(1));
+	}
+
+	(void)pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
+
+	ms = MAX(k_uptime_get() - load.start, 1);
+
+	if (load.err < 0) {
+		shell_error(sh, "Failed to load flash at 0x%08x (%d)", load.addr + load.programmed,
+			    load.err);
+		return;
+	}
+
+	shell_print(sh, "Loaded %u bytes in %u ms, %llu B/s, %u retries", load.programmed, ms,
+		    (uint64_t)load.programmed * MSEC_PER_SEC / ms, load.naks);
+	shell_print(sh, "Erase: %u ms, program: %u ms", load.erase_ms, load.prog_ms);
+}
+
+/* the host went quiet, end the load so that the shell and the flash are released */
+static void load_timeout_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	/* chunks queued behind this item would never be programmed otherwise */
+	load_handler(NULL);
+
+	if (load.err == 0 && load.programmed != load.size) {
+		load.err = -ETIMEDOUT;
+	}
+
+	load_stop(load_sh);
+}
+
+/* a chunk was fully received, program it if intact and in sequence */
+static void load_chunk(const struct shell *sh)
+{
+	uint16_t seq = sys_get_le16(&load.hdr[0]);
+	uint16_t len = sys_get_le16(&load.hdr[2]);
+	uint32_t crc;
+
+	if (load.drop) {
+		/* the ACK of a programmed chunk was lost, the host sends it again */
+		if (seq < load.acked) {
+			shell_print(sh, "ACK %u", load.acked - 1U);
+		}
+		return;
+	}
+
+	crc = crc32_ieee_update(crc32_ieee(load.hdr, sizeof(load.hdr)), load_buf[load.rx], len);
+	if (crc != sys_get_le32(load.crc)) {
+		/* go back to this chunk, later ones are dropped until it is sent again */
+		load.naks++;
+		shell_print(sh, "NAK %u %d", load.seq, -EBADMSG);
+		return;
+	}
+
+	/* an empty chunk ends the load, early if the host gave up */
+	if (len == 0U) {
+		if (load.received != load.size) {
+			load.err = -ECANCELED;
+		}
+		load.done = true;
+		return;
+	}
+
+	load.len[load.rx] = len;
+	load.chunk_seq[load.rx] = load.seq;
+	atomic_set_bit(&load_ready, load.rx);
+	(void)k_work_submit_to_queue(&flash_wq, &load_work);
+
+	load.rx ^= 1U;
+	load.seq++;
+	load.received += len;
+}
+
+/*
+ * The host sends chunks of LOAD_CHUNK bytes (the last one may be shorter):
+ * a sequence number and a length (16 bits each), the data and a CRC32 of
+ * all of them. Each chunk is acknowledged with "ACK SEQ" once programmed, or
+ * "NAK SEQ ERR" if it must be sent again. The host keeps at most two chunks
+ * unacknowledged, one being received while the other one is programmed.
+ * Chunks programmed already are acknowledged again, in case the ACK was lost.
+ *
+ * An empty chunk ends the load, and aborts it if sent early. After a
+ * programming error, the next byte received ends the load, and without
+ * traffic for LOAD_IDLE_MS the load ends on its own.
+ */
+static void load_bypass(const struct shell *sh, uint8_t *data, size_t len)
+{
+	int64_t now = k_uptime_get();
+
+	(void)k_work_reschedule_for_queue(&flash_wq, &load_timeout, K_MSEC(LOAD_IDLE_MS));
+
+	if (load.state != LOAD_HEADER || load.left != LOAD_HDR_LEN) {
+		if (now - load.last_rx > LOAD_GAP_MS) {
+			load.state = LOAD_HEADER;
+			load.dst = load.hdr;
+			load.left = LOAD_HDR_LEN;
+		}
+	}
+
+	load.last_rx = now;
+
+	while (len > 0U && load.err == 0) {
+		size_t n = MIN(len, load.left);
+
+		/* dropped chunks are not stored, their buffer may be in use */
+		if (load.dst != NULL) {
+			memcpy(load.dst, data, n);
+			load.dst += n;
+		}
+
+		load.left -= n;
+		data += n;
+		len -= n;
+
+		if (load.left > 0U) {
+			continue;
+		}
+
+		switch (load.state) {
+		case LOAD_HEADER:
+			load.left = sys_get_le16(&load.hdr[2]);
+			if (load.left > LOAD_CHUNK) {
+				load.err = -EPROTO;
+				break;
+			}
+			/* the end chunk only has a CRC */
+			if (load.left == 0U) {
+				load.drop = false;
+				load.dst = load.crc;
+				load.left = sizeof(load.crc);
+				load.state = LOAD_CRC;
+				break;
+			}
+			/* sent already, out of sequence, or both buffers still in use */
+			load.drop = sys_get_le16(&load.hdr[0]) != load.seq ||
+				    atomic_test_bit(&load_ready, load.rx);
+			if (!load.drop && load.left > load.size - load.received) {
+				load.err = -EPROTO;
+				break;
+			}
+			load.dst = load.drop ? NULL : load_buf[load.rx];
+			load.state = LOAD_DATA;
+			break;
+		case LOAD_DATA:
+			load.dst = load.crc;
+			load.left = sizeof(load.crc);
+			load.state = LOAD_CRC;
+			break;
+		case LOAD_CRC:
+			load_chunk(sh);
+			load.dst = load.hdr;
+			load.left = LOAD_HDR_LEN;
+			load.state = LOAD_HEADER;
+			break;
+		}
+
+		if (load.done) {
+			load_stop(sh);
+			return;
+		}
+	}
+
+	if (load.err < 0) {
+		load_stop(sh);
+	}
+}
+
+static int cmd_flash_load(const struct shell *sh, size_t argc, char **argv)
+{
+	struct flash_pages_info info;
+	uint32_t addr, size;
+	int ret;
+
+	if (!initialized) {
+		shell_error(sh, "Flash module not initialized");
+		return -EPERM;
+	}
+
+	addr = strtoul(argv[1], NULL, 0);
+	size = strtoul(argv[2], NULL, 0);
+
+	if (size == 0U || DIV_ROUND_UP(size, LOAD_CHUNK) > UINT16_MAX) {
+		shell_error(sh, "Invalid size");
+		return -EINVAL;
+	}
+
+	ret = pm_device_action_run(flash, PM_DEVICE_ACTION_RESUME);
+	if (ret < 0) {
+		shell_error(sh, "Failed to resume flash (%d)", ret);
+		return ret;
+	}
+
+	/* erasing ahead must not touch data before the address */
+	ret = flash_get_page_info_by_offs(flash, addr, &info);
+	if (ret < 0 || info.start_offset != addr) {
+		shell_error(sh, "Address must be at the start of a page");
+		(void)pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
+		return -EINVAL;
+	}
+
+	memset(&load, 0, sizeof(load));
+	load.state = LOAD_HEADER;
+	load.dst = load.hdr;
+	load.left = LOAD_HDR_LEN;
+	load.addr = addr;
+	load.size = size;
+	load.erased = addr;
+	load.start = k_uptime_get();
+	load.last_rx = load.start;
+	load_sh = sh;
+	atomic_clear(&load_ready);
+	atomic_set(&load_active, 1);
+
+	shell_print(sh, "Loading, send chunks");
+
+	shell_set_bypass(sh, load_bypass);
+	(void)k_work_reschedule_for_queue(&flash_wq, &load_timeout, K_MSEC(LOAD_IDLE_MS));
+
+	return 0;
+}
+
+static void bench_add(struct bench_result *r, timing_t start, timing_t end)
+{
+	uint32_t us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+	r->min_us = (r->count == 0U) ? us : MIN(r->min_us, us);
+	r->max_us = MAX(r->max_us, us);
+	r->total_us += us;
+	r->count++;
+}
+
+/* bytes is the size of each operation, 0 if the throughput does not matter */
+static void bench_print(const struct shell *sh, bool csv, const char *name, uint32_t bytes,
+			const struct bench_result *r)
+{
+	uint64_t bps = 0U;
+
+	if (r->count == 0U) {
+		return;
+	}
+
+	if (bytes > 0U) {
+		bps = (uint64_t)bytes * r->count * USEC_PER_SEC / MAX(r->total_us, 1U);
+	}
+
+	if (csv) {
+		shell_print(sh, "bench,%s,%u,%u,%u,%llu,%u,%llu", name, bytes, r->count, r->min_us,
+			    r->total_us / r->count, r->max_us, bps);
+		return;
+	}
+
+	shell_print(sh, "%-10s %5u B x %4u: min %6u us, avg %6llu us, max %6u us, %llu.%02llu MB/s",
+		    name, bytes, r->count, r->min_us, r->total_us / r->count, r->max_us,
+		    bps / 1000000U, bps / 10000U % 100U);
+}
+
+/* xorshift32, reproducible offsets for the random reads */
+static uint32_t bench_rand(uint32_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+static int bench_read(const struct shell *sh, const struct flash_area *fa, bool csv)
+{
+	uint32_t seed = 0x12345678U;
+	int ret;
+
+	for (size_t i = 0U; i < ARRAY_SIZE(bench_read_sizes); i++) {
+		uint32_t size = bench_read_sizes[i];
+		uint32_t total = MIN(BENCH_READ_TOTAL, fa->fa_size);
+		struct bench_result seq = {0};
+		struct bench_result rnd = {0};
+
+		for (uint32_t off = 0U; off + size <= total; off += size) {
+			timing_t start = timing_counter_get();
+
+			ret = flash_area_read(fa, off, bench_buf, size);
+			if (ret < 0) {
+				return ret;
+			}
+
+			bench_add(&seq, start, timing_counter_get());
+		}
+
+		for (uint32_t n = 0U; n < BENCH_RANDOM_READS; n++) {
+			uint32_t off = bench_rand(&seed) % (fa->fa_size / size) * size;
+			timing_t start = timing_counter_get();
+
+			ret = flash_area_read(fa, off, bench_buf, size);
+			if (ret < 0) {
+				return ret;
+			}
+
+			bench_add(&rnd, start, timing_counter_get());
+		}
+
+		bench_print(sh, csv, "seqread", size, &seq);
+		bench_print(sh, csv, "randread", size, &rnd);
+	}
+
+	return 0;
+}
+
+/* erase tests follow each other, the first one leaves a block ready to program */
+static int bench_erase(const struct shell *sh, const struct flash_area *fa, bool csv)
+{
+	uint32_t off = 0U;
+	int ret;
+
+	for (size_t i = 0U; i < ARRAY_SIZE(bench_erases); i++) {
+		const struct bench_erase *e = &bench_erases[i];
+		struct bench_result r = {0};
+
+		for (uint32_t n = 0U; n < e->count && off + e->size <= fa->fa_size; n++) {
+			timing_t start = timing_counter_get();
+
+			ret = flash_area_erase(fa, off, e->size);
+			if (ret < 0) {
+				return ret;
+			}
+
+			bench_add(&r, start, timing_counter_get());
+			off += e->size;
+		}
+
+		bench_print(sh, csv, e->name, e->size, &r);
+	}
+
+	return 0;
+}
+
+static int bench_program(const struct shell *sh, const struct flash_area *fa, bool csv)
+{
+	struct bench_result r = {0};
+	int ret;
+
+	for (uint32_t i = 0U; i < BENCH_PAGE; i++) {
+		bench_buf[i] = i;
+	}
+
+	for (uint32_t off = 0U; off < MIN(BENCH_PROGRAM_SIZE, fa->fa_size); off += BENCH_PAGE) {
+		timing_t start = timing_counter_get();
+
+		ret = flash_area_write(fa, off, bench_buf, BENCH_PAGE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		bench_add(&r, start, timing_counter_get());
+	}
+
+	bench_print(sh, csv, "program", BENCH_PAGE, &r);
+
+	return 0;
+}
+
+static int bench_chip_erase(const struct shell *sh, const struct flash_area *fa, bool csv)
+{
+	struct bench_result r = {0};
+	timing_t start;
+	int ret;
+
+	/* the whole chip is only fair game if it is all scratch */
+	if (fa->fa_off != 0 || fa->fa_size != BENCH_CHIP_SIZE) {
+		shell_error(sh, "Chip erase needs a scratch partition covering the whole chip");
+		return -EPERM;
+	}
+
+	start = timing_counter_get();
+
+	ret = flash_erase(fa->fa_dev, 0, BENCH_CHIP_SIZE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	bench_add(&r, start, timing_counter_get());
+	bench_print(sh, csv, "erasechip", BENCH_CHIP_SIZE, &r);
+
+	return 0;
+}
+
+static int cmd_flash_bench(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct flash_area *fa;
+	bool csv = false;
+	bool chip = false;
+	int ret;
+
+	if (!initialized) {
+		shell_error(sh, "Flash module not initialized");
+		return -EPERM;
+	}
+
+	for (size_t i = 1U; i < argc; i++) {
+		if (strcmp(argv[i], "csv") == 0) {
+			csv = true;
+		} else if (strcmp(argv[i], "chip") == 0) {
+			chip = true;
+		} else {
+			shell_error(sh, "Invalid option (csv, chip)");
+			return -EINVAL;
+		}
+	}
+
+	ret = flash_area_open(BENCH_PARTITION, &fa);
+	if (ret < 0) {
+		shell_error(sh, "Failed to open scratch partition (%d)", ret);
+		return ret;
+	}
+
+	ret = pm_device_action_run(flash, PM_DEVICE_ACTION_RESUME);
+	if (ret < 0) {
+		shell_error(sh, "Failed to resume flash (%d)", ret);
+		flash_area_close(fa);
+		return ret;
+	}
+
+	if (csv) {
+		shell_print(sh, "bench,test,bytes,count,min_us,avg_us,max_us,bytes_per_s");
+	} else {
+		shell_print(sh, "Scratch partition: 0x%08lx, %u bytes", (long)fa->fa_off,
+			    (uint32_t)fa->fa_size);
+	}
+
+	timing_init();
+	timing_start();
+
+	ret = bench_read(sh, fa, csv);
+	if (ret == 0) {
+		ret = bench_erase(sh, fa, csv);
+	}
+
+	if (ret == 0) {
+		ret = bench_program(sh, fa, csv);
+	}
+
+	if (ret == 0 && chip) {
+		ret = bench_chip_erase(sh, fa, csv);
+	}
+
+	timing_stop();
+
+	(void)pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
+	flash_area_close(fa);
+
+	if (ret < 0) {
+		shell_error(sh, "Benchmark failed (%d)", ret);
+	}
+
+	return ret;
+}
+
+/* generated from the address, nothing is stored */
+static inline uint32_t verify_expected(uint32_t addr)
+{
+	switch (verify_pattern) {
+	case VERIFY_ADDR:
+		return addr;
+	case VERIFY_CHECKER:
+		return ((addr / 4U) % 2U == 0U) ? 0x55555555U : 0xaaaaaaaaU;
+	default:
+		return 0U;
+	}
+}
+
+static void verify_bad(uint32_t addr, uint32_t expected, uint32_t val)
+{
+	struct verify_stats *st = &verify_stats;
+	uint32_t block = ROUND_DOWN(addr, KB(64));
+
+	if (st->bad_words < VERIFY_BAD_MAX) {
+		st->bad_addr[st->bad_words] = addr;
+		st->bad_expected[st->bad_words] = expected;
+		st->bad_read[st->bad_words] = val;
+	}
+
+	st->bad_words++;
+	st->bits_to_0 += __builtin_popcount(expected & ~val);
+	st->bits_to_1 += __builtin_popcount(~expected & val);
+
+	if (st->bad_blocks == 0U || block != st->last_bad_block) {
+		if (st->bad_blocks < VERIFY_BAD_MAX) {
+			st->bad_block[st->bad_blocks] = block;
+		}
+
+		st->bad_blocks++;
+		st->last_bad_block = block;
+	}
+}
+
+/* compare the chunks read back, in the shell thread, until the range is done */
+static void verify_compare(void)
+{
+	for (;;) {
+		(void)k_sem_take(&verify_filled, K_FOREVER);
+
+		if (!atomic_test_bit(&verify_ready, verify_check)) {
+			return;
+		}
+
+		const struct verify_chunk *c = &verify_chunks[verify_check];
+		const uint8_t *buf = verify_buf[verify_check];
+
+		for (uint32_t off = 0U; off < VERIFY_CHUNK; off += 4U) {
+			uint32_t addr = c->addr + off;
+			uint32_t expected = c->blank ? VERIFY_BLANK : verify_expected(addr);
+			uint32_t val = sys_get_le32(&buf[off]);
+
+			if (val != expected) {
+				verify_bad(addr, expected, val);
+			}
+		}
+
+		atomic_clear_bit(&verify_ready, verify_check);
+		verify_check ^= 1U;
+		k_sem_give(&verify_free);
+	}
+}
+
+/* read a block back, the previous chunk is compared in the meantime */
+static int verify_read(uint32_t addr, uint32_t size, bool blank, uint8_t *fill)
+{
+	int ret;
+
+	for (uint32_t off = 0U; off < size; off += VERIFY_CHUNK) {
+		(void)k_sem_take(&verify_free, K_FOREVER);
+
+		ret = flash_read(flash, addr + off, verify_buf[*fill], VERIFY_CHUNK);
+		if (ret < 0) {
+			k_sem_give(&verify_free);
+			return ret;
+		}
+
+		verify_chunks[*fill].addr = addr + off;
+		verify_chunks[*fill].blank = blank;
+		atomic_set_bit(&verify_ready, *fill);
+		k_sem_give(&verify_filled);
+
+		*fill ^= 1U;
+	}
+
+	return 0;
+}
+
+static int verify_program(uint32_t addr, uint32_t size)
+{
+	int ret;
+
+	for (uint32_t off = 0U; off < size; off += VERIFY_PAGE) {
+		for (uint32_t i = 0U; i < VERIFY_PAGE; i += 4U) {
+			sys_put_le32(verify_expected(addr + off + i), &verify_page[i]);
+		}
+
+		ret = flash_write(flash, addr + off, verify_page, VERIFY_PAGE);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * March over the range, one erase block at a time: erase, read back as
+ * blank, program the pattern, read back the pattern. This runs on the flash
+ * work queue, above the shell thread, which compares each chunk read back
+ * whenever the flash operation that follows, including the next erase,
+ * leaves the CPU idle.
+ */
+static void verify_handler(struct k_work *work)
+{
+	uint32_t addr = verify_range.addr;
+	uint32_t end = addr + verify_range.size;
+	uint8_t fill = 0U;
+	int ret = 0;
+
+	ARG_UNUSED(work);
+
+	while (addr < end && ret == 0) {
+		uint32_t block = KB(4);
+
+		if (addr % KB(64) == 0U && end - addr >= KB(64)) {
+			block = KB(64);
+		}
+
+		ret = flash_erase(flash, addr, block);
+		if (ret == 0) {
+			ret = verify_read(addr, block, true, &fill);
+		}
+
+		if (ret == 0) {
+			ret = verify_program(addr, block);
+		}
+
+		if (ret == 0) {
+			ret = verify_read(addr, block, false, &fill);
+		}
+
+		addr += block;
+	}
+
+	verify_range.ret = ret;
+	k_sem_give(&verify_filled);
+}
+
+static int verify_run(uint32_t addr, uint32_t size)
+{
+	verify_range.addr = addr;
+	verify_range.size = size;
+
+	(void)k_work_submit_to_queue(&flash_wq, &verify_work);
+	verify_compare();
+
+	return verify_range.ret;
+}
+
+static int cmd_flash_verify(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct verify_stats *st = &verify_stats;
+	uint32_t addr, size;
+	int64_t start;
+	uint32_t ms;
+	int ret;
+
+	if (!initialized) {
+		shell_error(sh, "Flash module not initialized");
+		return -EPERM;
+	}
+
+	addr = strtoul(argv[1], NULL, 0);
+	size = strtoul(argv[2], NULL, 0);
+
+	if (size == 0U || addr % KB(4) != 0U || size % KB(4) != 0U ||
+	    addr + size > BENCH_CHIP_SIZE || addr + size < addr) {
+		shell_error(sh, "Range must be 4 KB aligned and within the %u byte chip",
+			    (uint32_t)BENCH_CHIP_SIZE);
+		return -EINVAL;
+	}
+
+	verify_pattern = VERIFY_ADDR;
+	if (argc > 3) {
+		if (strcmp(argv[3], "checker") == 0) {
+			verify_pattern = VERIFY_CHECKER;
+		} else if (strcmp(argv[3], "zeros") == 0) {
+			verify_pattern = VERIFY_ZEROS;
+		} else if (strcmp(argv[3], "addr") != 0) {
+			shell_error(sh, "Invalid pattern (addr, checker, zeros)");
+			return -EINVAL;
+		}
+	}
+
+	ret = pm_device_action_run(flash, PM_DEVICE_ACTION_RESUME);
+	if (ret < 0) {
+		shell_error(sh, "Failed to resume flash (%d)", ret);
+		return ret;
+	}
+
+	memset(&verify_stats, 0, sizeof(verify_stats));
+	atomic_clear(&verify_ready);
+	verify_check = 0U;
+	k_sem_reset(&verify_filled);
+
+	start = k_uptime_get();
+	ret = verify_run(addr, size);
+	ms = MAX(k_uptime_get() - start, 1);
+
+	(void)pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
+
+	if (ret < 0) {
+		shell_error(sh, "Flash operation failed (%d)", ret);
+		return ret;
+	}
+
+	shell_print(sh, "Verified 0x%08x-0x%08x in %u ms, %llu.%02llu MB/s", addr, addr + size - 1U,
+		    ms, (uint64_t)size / 1000U / ms, (uint64_t)size / 10U / ms % 100U);
+
+	if (st->bad_words == 0U) {
+		shell_print(sh, "No errors");
+		return 0;
+	}
+
+	shell_error(sh, "%u bad words in %u blocks, %u bits read 0, %u bits read 1", st->bad_words,
+		    st->bad_blocks, st->bits_to_0, st->bits_to_1);
+
+	for (uint32_t i = 0U; i < MIN(st->bad_words, VERIFY_BAD_MAX); i++) {
+		shell_error(sh, "  0x%08x: expected %08x, read %08x", st->bad_addr[i],
+			    st->bad_expected[i], st->bad_read[i]);
+	}
+
+	for (uint32_t i = 0U; i < MIN(st->bad_blocks, VERIFY_BAD_MAX); i++) {
+		shell_error(sh, "  bad block 0x%08x", st->bad_block[i]);
+	}
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_flash_cmds, SHELL_CMD(id, NULL, "Read flash ID", cmd_flash_id),
 	SHELL_CMD_ARG(erase, NULL, "Erase page: erase PAGE_ADDR", cmd_flash_erase, 2, 0),
 	SHELL_CMD_ARG(read, NULL, "Read: read ADDR NUM_BYTES", cmd_flash_read, 3, 0),
+	SHELL_CMD_ARG(dump, NULL, "Binary read for scripts/flashdump.py: dump ADDR NUM_BYTES",
+		      cmd_flash_dump, 3, 0),
+	SHELL_CMD_ARG(load, NULL, "Program data sent by scripts/flashload.py: load ADDR NUM_BYTES",
+		      cmd_flash_load, 3, 0),
+	SHELL_CMD_ARG(bench, NULL, "Benchmark the scratch partition: bench [csv] [chip]",
+		      cmd_flash_bench, 1, 2),
+	SHELL_CMD_ARG(verify, NULL, "Destructive march test: verify ADDR SIZE [addr|checker|zeros]",
+		      cmd_flash_verify, 3, 1),
 	SHELL_CMD_ARG(write, NULL, "Write: write ADDR DATA", cmd_flash_write, 3, 0),
 	SHELL_SUBCMD_SET_END);
 
@@ -195,12 +1314,22 @@ SHELL_SUBCMD_ADD((hwv), flash, &sub_flash_cmds, "Flash", NULL, 0, 0);
 
 int flash_init(void)
 {
+	const struct k_work_queue_config cfg = {.name = "flash"};
 	int ret;
 
 	if (!device_is_ready(flash)) {
 		return -ENODEV;
 	}
 
+	k_work_init(&dump_work, dump_handler);
+	k_work_init(&load_work, load_handler);
+	k_work_init_delayable(&load_timeout, load_timeout_handler);
+	k_work_init(&verify_work, verify_handler);
+
+	/* erases take up to seconds, keep them off the system work queue */
+	k_work_queue_start(&flash_wq, flash_stack, K_THREAD_STACK_SIZEOF(flash_stack), FLASH_PRIO,
+			   &cfg);
+
 	ret = pm_device_action_run(flash, PM_DEVICE_ACTION_SUSPEND);
 	if (ret < 0) {
 		return ret;
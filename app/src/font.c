@@ -0,0 +1,98 @@
+#include "font.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+#define FONT_FIRST ' '
+#define FONT_LAST  'Z'
+
+/* glyph height, in pixels, glyphs being 5 pixels wide */
+#define FONT_GLYPH_HEIGHT 7U
+
+/* glyphs are scaled up vertically to fill the cell */
+#define FONT_SCALE (FONT_CELL_HEIGHT / (FONT_GLYPH_HEIGHT + 1U))
+
+/* 5x7 glyphs, one byte per line, leftmost pixel in bit 0, 1 for ink */
+static const uint8_t font_glyphs[FONT_LAST - FONT_FIRST + 1][FONT_GLYPH_HEIGHT] = {
+	['%' - FONT_FIRST] = {0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18},
+	['+' - FONT_FIRST] = {0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00},
+	['-' - FONT_FIRST] = {0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00},
+	['.' - FONT_FIRST] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06},
+	['/' - FONT_FIRST] = {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},
+	['0' - FONT_FIRST] = {0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e},
+	['1' - FONT_FIRST] = {0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0e},
+	['2' - FONT_FIRST] = {0x0e, 0x11, 0x10, 0x08, 0x04, 0x02, 0x1f},
+	['3' - FONT_FIRST] = {0x1f, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0e},
+	['4' - FONT_FIRST] = {0x08, 0x0c, 0x0a, 0x09, 0x1f, 0x08, 0x08},
+	['5' - FONT_FIRST] = {0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e},
+	['6' - FONT_FIRST] = {0x0c, 0x02, 0x01, 0x0f, 0x11, 0x11, 0x0e},
+	['7' - FONT_FIRST] = {0x1f, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02},
+	['8' - FONT_FIRST] = {0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e},
+	['9' - FONT_FIRST] = {0x0e, 0x11, 0x11, 0x1e, 0x10, 0x08, 0x06},
+	[':' - FONT_FIRST] = {0x00, 0x06, 0x06, 0x00, 0x06, 0x06, 0x00},
+	['A' - FONT_FIRST] = {0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11},
+	['B' - FONT_FIRST] = {0x0f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f},
+	['C' - FONT_FIRST] = {0x0e, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0e},
+	['D' - FONT_FIRST] = {0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07},
+	['E' - FONT_FIRST] = {0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x1f},
+	['F' - FONT_FIRST] = {0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x01},
+	['G' - FONT_FIRST] = {0x0e, 0x11, 0x01, 0x1d, 0x11, 0x11, 0x1e},
+	['H' - FONT_FIRST] = {0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11},
+	['I' - FONT_FIRST] = {0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e},
+	['J' - FONT_FIRST] = {0x1c, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06},
+	['K' - FONT_FIRST] = {0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11},
+	['L' - FONT_FIRST] = {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1f},
+	['M' - FONT_FIRST] = {0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11},
+	['N' - FONT_FIRST] = {0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11},
+	['O' - FONT_FIRST] = {0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e},
+	['P' - FONT_FIRST] = {0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01},
+	['Q' - FONT_FIRST] = {0x0e, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16},
+	['R' - FONT_FIRST] = {0x0f, 0x11, 0x11, 0x0f, 0x05, 0x09, 0x11},
+	['S' - FONT_FIRST] = {0x1e, 0x01, 0x01, 0x0e, 0x10, 0x10, 0x0f},
+	['T' - FONT_FIRST] = {0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},
+	['U' - FONT_FIRST] = {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e},
+	['V' - FONT_FIRST] = {0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04},
+	['W' - FONT_FIRST] = {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a},
+	['X' - FONT_FIRST] = {0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11},
+	['Y' - FONT_FIRST] = {0x11, 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04},
+	['Z' - FONT_FIRST] = {0x1f, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1f},
+};
+
+static uint8_t font_cache[ARRAY_SIZE(font_glyphs)][FONT_CELL_HEIGHT];
+
+void font_init(void)
+{
+	for (size_t i = 0U; i < ARRAY_SIZE(font_glyphs); i++) {
+		/* one pixel margin on the left, white background */
+		memset(font_cache[i], 0xff, FONT_CELL_HEIGHT);
+
+		for (uint8_t line = 0U; line < FONT_GLYPH_HEIGHT * FONT_SCALE; line++) {
+			font_cache[i][FONT_SCALE / 2U + line] =
+				~(font_glyphs[i][line / FONT_SCALE] << 1U);
+		}
+	}
+}
+
+void font_draw(const struct raster *r, uint16_t col, uint16_t row, char c)
+{
+	const uint8_t *glyph;
+	uint8_t *cell;
+
+	if ((col + 1U) * FONT_CELL_WIDTH > r->width || (row + 1U) * FONT_CELL_HEIGHT > r->height) {
+		return;
+	}
+
+	c = toupper((unsigned char)c);
+	if (c < FONT_FIRST || c > FONT_LAST) {
+		c = ' ';
+	}
+
+	glyph = font_cache[c - FONT_FIRST];
+	cell = &r->buf[row * FONT_CELL_HEIGHT * r->pitch + col];
+
+	for (uint8_t line = 0U; line < FONT_CELL_HEIGHT; line++) {
+		cell[line * r->pitch] = glyph[line];
+	}
+}
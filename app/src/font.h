@@ -0,0 +1,34 @@
+#ifndef APP_SRC_FONT_H_
+#define APP_SRC_FONT_H_
+
+#include <stdint.h>
+
+#include "raster.h"
+
+/** Character cell width, in pixels. */
+#define FONT_CELL_WIDTH 8U
+/** Character cell height, in pixels. */
+#define FONT_CELL_HEIGHT 16U
+
+/**
+ * @brief Render the glyph cache.
+ *
+ * Glyphs are pre-rendered in the raster format, one byte per cell line, so
+ * that drawing a character is a plain copy of FONT_CELL_HEIGHT bytes.
+ */
+void font_init(void);
+
+/**
+ * @brief Draw a character.
+ *
+ * Supports digits, upper case letters (lower case ones are drawn as upper case
+ * letters) and a few symbols. Other characters are drawn as spaces.
+ *
+ * @param r Raster.
+ * @param col Cell column, each cell being one byte wide.
+ * @param row Cell row.
+ * @param c Character.
+ */
+void font_draw(const struct raster *r, uint16_t col, uint16_t row, char c);
+
+#endif /* APP_SRC_FONT_H_ */
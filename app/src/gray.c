@@ -0,0 +1,214 @@
+#include "gray.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#define GRAY_DISPLAY DT_CHOSEN(zephyr_display)
+#define GRAY_WIDTH   DT_PROP(GRAY_DISPLAY, width)
+#define GRAY_HEIGHT  DT_PROP(GRAY_DISPLAY, height)
+#define GRAY_PHASES  (GRAY_LEVELS_MAX - 1U)
+
+#define GRAY_SERIAL_VCOM DT_ENUM_HAS_VALUE(GRAY_DISPLAY, vcom_mode, serial)
+/* shortest VCOM period the driver accepts */
+#define GRAY_VCOM_MIN_US                                                                           \
+	(DIV_ROUND_UP(MSEC_PER_SEC, DT_PROP(GRAY_DISPLAY, max_vcom_frequency)) * USEC_PER_MSEC)
+
+#define GRAY_STACK_SIZE 1024
+/* above the compositor, phases must not wait for it */
+#define GRAY_PRIO       K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_DEFINE(gray_stack, GRAY_STACK_SIZE);
+static struct k_work_q gray_wq;
+static struct k_work phase_work;
+static struct k_timer phase_timer;
+
+static uint8_t planes[GRAY_PHASES][GRAY_HEIGHT][GRAY_WIDTH / 8];
+/* lines that differ from the previous phase, [first, last) */
+static uint16_t first[GRAY_PHASES];
+static uint16_t last[GRAY_PHASES];
+
+static const struct device *display;
+static uint8_t phases;
+static uint8_t phase;
+static bool running;
+static struct gray_stats stats;
+
+static void gray_phase(struct k_work *work)
+{
+	struct display_buffer_descriptor desc = {
+		.width = GRAY_WIDTH,
+		.pitch = GRAY_WIDTH,
+	};
+	uint32_t ticks, us;
+	timing_t start, end;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	/* more than one expiry since the last phase means this one is late */
+	ticks = k_timer_status_get(&phase_timer);
+	if (ticks > 1U) {
+		stats.late += ticks - 1U;
+	}
+
+	phase = (phase + 1U) % phases;
+	stats.phases++;
+
+	if (first[phase] >= last[phase]) {
+		return;
+	}
+
+	desc.height = last[phase] - first[phase];
+
+	start = timing_counter_get();
+	ret = display_write(display, 0, first[phase], &desc, planes[phase][first[phase]]);
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		stats.errors++;
+		return;
+	}
+
+	us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+
+	stats.lines += desc.height;
+	stats.write_us += us;
+	stats.max_write_us = MAX(stats.max_write_us, us);
+}
+
+static void gray_tick(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	(void)k_work_submit_to_queue(&gray_wq, &phase_work);
+}
+
+int gray_init(const struct device *disp)
+{
+	const struct k_work_queue_config cfg = {.name = "gray"};
+
+	display = disp;
+
+	k_work_init(&phase_work, gray_phase);
+	k_timer_init(&phase_timer, gray_tick, NULL);
+	k_work_queue_start(&gray_wq, gray_stack, K_THREAD_STACK_SIZEOF(gray_stack), GRAY_PRIO,
+			   &cfg);
+
+	return 0;
+}
+
+int gray_start(uint8_t levels, uint32_t hz, gray_row_t row)
+{
+	uint8_t gray[GRAY_WIDTH];
+	uint32_t period_us, cycle_us, vcom_us, slack_us;
+	int ret;
+
+	if (levels < 2U || levels > GRAY_LEVELS_MAX || hz == 0U || hz > GRAY_HZ_MAX) {
+		return -EINVAL;
+	}
+
+	if (running) {
+		return -EBUSY;
+	}
+
+	phases = levels - 1U;
+	period_us = USEC_PER_SEC / hz;
+
+	/* pixels of level n are white in the first n phases */
+	memset(planes, 0, sizeof(planes));
+
+	for (uint16_t y = 0U; y < GRAY_HEIGHT; y++) {
+		row(y, gray);
+
+		for (uint16_t x = 0U; x < GRAY_WIDTH; x++) {
+			uint8_t level = (gray[x] * phases + 127U) / 255U;
+
+			for (uint8_t p = 0U; p < level; p++) {
+				planes[p][y][x / 8U] |= BIT(x % 8U);
+			}
+		}
+	}
+
+	for (uint8_t p = 0U; p < phases; p++) {
+		uint8_t prev = (p + phases - 1U) % phases;
+
+		first[p] = GRAY_HEIGHT;
+		last[p] = 0U;
+
+		for (uint16_t y = 0U; y < GRAY_HEIGHT; y++) {
+			if (memcmp(planes[p][y], planes[prev][y], sizeof(planes[p][y])) != 0) {
+				first[p] = MIN(first[p], y);
+				last[p] = y + 1U;
+			}
+		}
+	}
+
+	/* the first tick shows phase 0, all its lines are sent */
+	first[0] = 0U;
+	last[0] = GRAY_HEIGHT;
+	phase = phases - 1U;
+
+	/*
+	 * One inversion per whole number of cycles of phases, as often as the
+	 * panel allows. The EXTCOMIN PWM runs freely, so its period is exactly
+	 * that. In serial mode, writes invert VCOM once the period has elapsed,
+	 * so the period is kept half a phase shorter to stay on the same phase
+	 * despite timer jitter.
+	 */
+	cycle_us = phases * period_us;
+	slack_us = GRAY_SERIAL_VCOM ? period_us / 2U : 0U;
+	vcom_us = DIV_ROUND_UP(GRAY_VCOM_MIN_US + slack_us, cycle_us) * cycle_us - slack_us;
+
+	ret = ls013b7dh05_set_vcom_period(display, DIV_ROUND_CLOSEST(vcom_us, USEC_PER_MSEC));
+	if (ret < 0) {
+		return ret;
+	}
+
+	memset(&stats, 0, sizeof(stats));
+
+	timing_init();
+	timing_start();
+
+	running = true;
+	k_timer_start(&phase_timer, K_NO_WAIT, K_USEC(period_us));
+
+	return 0;
+}
+
+int gray_stop(void)
+{
+	struct k_work_sync sync;
+
+	if (!running) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&phase_timer);
+	(void)k_work_cancel_sync(&phase_work, &sync);
+
+	running = false;
+	timing_stop();
+
+	/* the image is static again */
+	(void)ls013b7dh05_set_vcom_period(display, 0U);
+
+	return 0;
+}
+
+bool gray_is_running(void)
+{
+	return running;
+}
+
+void gray_get_stats(struct gray_stats *out)
+{
+	*out = stats;
+}
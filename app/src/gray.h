@@ -0,0 +1,94 @@
+#ifndef APP_SRC_GRAY_H_
+#define APP_SRC_GRAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** Maximum number of gray levels. */
+#define GRAY_LEVELS_MAX 4U
+
+/** Maximum phase rate, in Hz. */
+#define GRAY_HZ_MAX 200U
+
+/** @brief Grayscale mode statistics. */
+struct gray_stats {
+	/** Number of phases shown. */
+	uint32_t phases;
+	/** Number of phases that started late, after the next timer tick. */
+	uint32_t late;
+	/** Number of failed writes. */
+	uint32_t errors;
+	/** Number of lines written. */
+	uint32_t lines;
+	/** Longest phase write, in microseconds. */
+	uint32_t max_write_us;
+	/** Total phase write duration, in microseconds. */
+	uint64_t write_us;
+};
+
+/**
+ * @brief Grayscale row source.
+ *
+ * @param y Row.
+ * @param row Where to store the row, 8 bits per pixel, 0 being black.
+ */
+typedef void (*gray_row_t)(uint16_t y, uint8_t *row);
+
+/**
+ * @brief Initialize the grayscale mode.
+ *
+ * @param disp Display device.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int gray_init(const struct device *disp);
+
+/**
+ * @brief Start showing a grayscale image.
+ *
+ * Gray levels are obtained by frame rate modulation: the image is quantized
+ * to @p levels levels, and split in levels - 1 phases, a pixel of level n
+ * being white in n of them. Phases are shown in turn on a timer, and only the
+ * lines that differ from the previous phase are sent. VCOM is inverted once
+ * per whole number of cycles of phases, no faster than the panel allows, so
+ * that each phase sees both polarities.
+ *
+ * @param levels Number of gray levels, 2 to GRAY_LEVELS_MAX.
+ * @param hz Phase rate, 1 to GRAY_HZ_MAX.
+ * @param row Image source.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL If @p levels or @p hz is out of range.
+ * @retval -EBUSY If already started.
+ * @retval -errno Other negative errno code on failure.
+ */
+int gray_start(uint8_t levels, uint32_t hz, gray_row_t row);
+
+/**
+ * @brief Stop showing the grayscale image.
+ *
+ * The last phase stays on the panel.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY If not started.
+ */
+int gray_stop(void);
+
+/**
+ * @brief Check whether a grayscale image is being shown.
+ *
+ * @return true if started, false otherwise.
+ */
+bool gray_is_running(void);
+
+/**
+ * @brief Obtain statistics since the last start.
+ *
+ * @param stats Where to store the statistics.
+ */
+void gray_get_stats(struct gray_stats *stats);
+
+#endif /* APP_SRC_GRAY_H_ */
@@ -9,6 +9,7 @@
 #include "mag.h"
 #include "mic.h"
 #include "press.h"
+#include "ui.h"
 
 #include <stdio.h>
 
@@ -80,5 +81,12 @@ int main(void)
 		printf("Failed to initialize speaker module (%d)\n", ret);
 	}
 
+#ifdef CONFIG_LVGL
+	ret = ui_init();
+	if (ret < 0) {
+		printf("Failed to initialize UI module (%d)\n", ret);
+	}
+#endif
+
 	return 0;
 }
@@ -0,0 +1,173 @@
+#include "pattern.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+struct pattern {
+	const char *name;
+	void (*render)(const struct raster *r, uint32_t arg);
+	uint32_t arg;
+};
+
+/* 4x4 ordered dither thresholds */
+static const uint8_t bayer4[4][4] = {
+	{0U, 8U, 2U, 10U},
+	{12U, 4U, 14U, 6U},
+	{3U, 11U, 1U, 9U},
+	{15U, 7U, 13U, 5U},
+};
+
+static inline uint8_t *pattern_line(const struct raster *r, uint16_t y)
+{
+	return &r->buf[y * r->pitch];
+}
+
+/*
+ * Replicate the first period lines at y over h lines. The copied block doubles
+ * on each step, and stays a multiple of the period until the last one.
+ */
+static void pattern_repeat(const struct raster *r, uint16_t y, uint16_t h, uint16_t period)
+{
+	uint16_t done = MIN(period, h);
+
+	while (done < h) {
+		uint16_t n = MIN(done, h - done);
+
+		memcpy(pattern_line(r, y + done), pattern_line(r, y), n * r->pitch);
+		done += n;
+	}
+}
+
+/* h lines of the same 32-pixel wide horizontal pattern */
+static void pattern_band(const struct raster *r, uint16_t y, uint16_t h, uint32_t word)
+{
+	raster_fill_pattern(r, 0U, y, r->width, 1U, word);
+	pattern_repeat(r, y, h, 1U);
+}
+
+static void pattern_solid(const struct raster *r, uint32_t word)
+{
+	pattern_band(r, 0U, r->height, word);
+}
+
+static void pattern_checker(const struct raster *r, uint32_t size)
+{
+	uint32_t word = 0U;
+
+	for (uint8_t bit = 0U; bit < 32U; bit++) {
+		if ((bit / size) % 2U == 0U) {
+			word |= BIT(bit);
+		}
+	}
+
+	pattern_band(r, 0U, MIN(size, r->height), word);
+	if (size < r->height) {
+		pattern_band(r, size, MIN(size, r->height - size), ~word);
+	}
+
+	pattern_repeat(r, 0U, r->height, 2U * size);
+}
+
+static void pattern_border(const struct raster *r, uint32_t arg)
+{
+	ARG_UNUSED(arg);
+
+	/* top line, then a white line with black edges for the others */
+	pattern_band(r, 0U, 1U, 0U);
+	pattern_band(r, 1U, 1U, UINT32_MAX);
+	raster_vline(r, 0U, 1U, 1U, RASTER_BLACK);
+	raster_vline(r, r->width - 1U, 1U, 1U, RASTER_BLACK);
+
+	pattern_repeat(r, 1U, r->height - 2U, 1U);
+	memcpy(pattern_line(r, r->height - 1U), pattern_line(r, 0U), r->pitch);
+}
+
+static void pattern_walk(const struct raster *r, uint32_t arg)
+{
+	ARG_UNUSED(arg);
+
+	/* one black pixel per line, moving right by one pixel on each line */
+	pattern_band(r, 0U, r->height, UINT32_MAX);
+
+	for (uint16_t y = 0U; y < r->height; y++) {
+		uint16_t x = y % r->width;
+
+		pattern_line(r, y)[x / 8U] &= ~BIT(x % 8U);
+	}
+}
+
+static void pattern_gray(const struct raster *r, uint32_t level)
+{
+	for (uint16_t y = 0U; y < MIN(ARRAY_SIZE(bayer4), r->height); y++) {
+		uint32_t nibble = 0U;
+
+		for (uint8_t x = 0U; x < ARRAY_SIZE(bayer4[0]); x++) {
+			if (bayer4[y][x] < level) {
+				nibble |= BIT(x);
+			}
+		}
+
+		pattern_band(r, y, 1U, nibble * 0x11111111U);
+	}
+
+	pattern_repeat(r, 0U, r->height, ARRAY_SIZE(bayer4));
+}
+
+static void pattern_address(const struct raster *r, uint32_t arg)
+{
+	size_t len = DIV_ROUND_UP(r->width, 8U);
+
+	ARG_UNUSED(arg);
+
+	/*
+	 * Each line shows its own gate line address (1-based) in binary, left
+	 * half as is and right half inverted, so that a line written to the
+	 * wrong address or with stuck data bits stands out.
+	 */
+	for (uint16_t y = 0U; y < r->height; y++) {
+		uint8_t *line = pattern_line(r, y);
+		uint8_t addr = y + 1U;
+
+		memset(line, addr, len / 2U);
+		memset(&line[len / 2U], (uint8_t)~addr, len - len / 2U);
+	}
+}
+
+static const struct pattern patterns[] = {
+	{"black", pattern_solid, 0U},
+	{"white", pattern_solid, UINT32_MAX},
+	{"checker1", pattern_checker, 1U},
+	{"checker2", pattern_checker, 2U},
+	{"checker4", pattern_checker, 4U},
+	{"checker8", pattern_checker, 8U},
+	{"checker16", pattern_checker, 16U},
+	{"border", pattern_border, 0U},
+	{"walk", pattern_walk, 0U},
+	{"gray25", pattern_gray, 4U},
+	{"gray50", pattern_gray, 8U},
+	{"gray75", pattern_gray, 12U},
+	{"address", pattern_address, 0U},
+};
+
+const char *pattern_name(size_t idx)
+{
+	if (idx >= ARRAY_SIZE(patterns)) {
+		return NULL;
+	}
+
+	return patterns[idx].name;
+}
+
+int pattern_render(const char *name, const struct raster *r)
+{
+	for (size_t i = 0U; i < ARRAY_SIZE(patterns); i++) {
+		if (strcmp(patterns[i].name, name) == 0) {
+			patterns[i].render(r, patterns[i].arg);
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
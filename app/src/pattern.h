@@ -0,0 +1,31 @@
+#ifndef APP_SRC_PATTERN_H_
+#define APP_SRC_PATTERN_H_
+
+#include <stddef.h>
+
+#include "raster.h"
+
+/**
+ * @brief Get the name of a test pattern.
+ *
+ * @param idx Pattern index.
+ *
+ * @return Pattern name, NULL if @p idx is out of range.
+ */
+const char *pattern_name(size_t idx);
+
+/**
+ * @brief Render a test pattern.
+ *
+ * The whole raster is overwritten. Patterns are built from a few template
+ * lines that are then replicated with memcpy().
+ *
+ * @param name Pattern name.
+ * @param r Raster.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if the pattern does not exist.
+ */
+int pattern_render(const char *name, const struct raster *r);
+
+#endif /* APP_SRC_PATTERN_H_ */
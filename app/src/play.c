@@ -0,0 +1,137 @@
+#include "play.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#include "asset.h"
+
+#define PLAY_DISPLAY DT_CHOSEN(zephyr_display)
+#define PLAY_WIDTH   DT_PROP(PLAY_DISPLAY, width)
+#define PLAY_HEIGHT  DT_PROP(PLAY_DISPLAY, height)
+
+static const struct device *display;
+static struct asset asset;
+
+static uint8_t *play_line(uint16_t y, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	return ls013b7dh05_get_line(display, y);
+}
+
+int play_init(const struct device *disp)
+{
+	display = disp;
+
+	return 0;
+}
+
+int play_asset(const char *name, uint32_t loops, struct play_stats *stats)
+{
+	struct ls013b7dh05_stats before, after;
+	struct display_capabilities caps;
+	uint64_t decode = 0U, write = 0U;
+	int64_t start, next;
+	int ret;
+
+	if (loops == 0U || loops > PLAY_LOOPS_MAX) {
+		return -EINVAL;
+	}
+
+	/* frames are decoded in place, in the framebuffer */
+	display_get_capabilities(display, &caps);
+	if (caps.current_orientation != DISPLAY_ORIENTATION_NORMAL) {
+		return -ENOTSUP;
+	}
+
+	ret = asset_open(&asset, name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (asset.info.frames == 0U) {
+		asset_close(&asset);
+		return -ENODATA;
+	}
+
+	if (asset.info.width != PLAY_WIDTH || asset.info.height != PLAY_HEIGHT) {
+		asset_close(&asset);
+		return -EMSGSIZE;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+	timing_init();
+	timing_start();
+
+	ls013b7dh05_get_stats(display, &before);
+	start = k_uptime_get();
+	next = start;
+
+	for (uint32_t loop = 0U; loop < loops && ret == 0; loop++) {
+		asset_rewind(&asset);
+
+		for (uint16_t frame = 0U; frame < asset.info.frames; frame++) {
+			struct display_buffer_descriptor band = {
+				.width = PLAY_WIDTH,
+				.pitch = PLAY_WIDTH,
+			};
+			timing_t t0, t1, t2;
+			uint16_t first, last;
+
+			t0 = timing_counter_get();
+
+			ret = asset_decode(&asset, play_line, NULL, &first, &last);
+			if (ret < 0) {
+				break;
+			}
+
+			t1 = timing_counter_get();
+
+			/*
+			 * a single transfer, only the lines decoded were marked as
+			 * changed, the others within the band are skipped
+			 */
+			if (first < last) {
+				band.height = last - first;
+				ret = display_write(display, 0, first, &band,
+						    ls013b7dh05_get_line(display, first));
+				if (ret < 0) {
+					break;
+				}
+			}
+
+			t2 = timing_counter_get();
+
+			decode += timing_cycles_get(&t0, &t1);
+			write += timing_cycles_get(&t1, &t2);
+			stats->lines += last - first;
+			stats->frames++;
+
+			if (asset.info.period_ms > 0U) {
+				next += asset.info.period_ms;
+				k_sleep(K_TIMEOUT_ABS_MS(next));
+			}
+		}
+	}
+
+	stats->elapsed_ms = k_uptime_get() - start;
+	ls013b7dh05_get_stats(display, &after);
+	stats->spi_bytes = after.bytes_sent - before.bytes_sent;
+	stats->decode_us = timing_cycles_to_ns(decode) / NSEC_PER_USEC;
+	stats->write_us = timing_cycles_to_ns(write) / NSEC_PER_USEC;
+	stats->flash_bytes = asset.bytes_read;
+
+	timing_stop();
+	asset_close(&asset);
+
+	return ret;
+}
@@ -0,0 +1,60 @@
+#ifndef APP_SRC_PLAY_H_
+#define APP_SRC_PLAY_H_
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** Maximum number of loops. */
+#define PLAY_LOOPS_MAX 1000U
+
+/** @brief Playback statistics. */
+struct play_stats {
+	/** Number of frames shown. */
+	uint32_t frames;
+	/** Number of lines decoded. */
+	uint32_t lines;
+	/** Number of bytes read from flash. */
+	uint32_t flash_bytes;
+	/** Number of bytes sent to the panel. */
+	uint64_t spi_bytes;
+	/** Total decode duration, in microseconds. */
+	uint64_t decode_us;
+	/** Total write duration, in microseconds. */
+	uint64_t write_us;
+	/** Playback duration, in milliseconds. */
+	uint32_t elapsed_ms;
+};
+
+/**
+ * @brief Initialize asset playback.
+ *
+ * @param disp Display device.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int play_init(const struct device *disp);
+
+/**
+ * @brief Play an asset.
+ *
+ * Frames are decoded in place, straight into the framebuffer lines, and each
+ * is sent as a single band covering the lines that changed, at the asset
+ * frame period. Returns once all loops were shown.
+ *
+ * @param name Asset name.
+ * @param loops Number of times the asset is played, 1 to PLAY_LOOPS_MAX.
+ * @param stats Where to store the statistics.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT If the asset does not exist.
+ * @retval -ENODATA If the asset has no frames.
+ * @retval -EMSGSIZE If the asset is not the size of the display.
+ * @retval -ENOTSUP If the display is not in the normal orientation.
+ * @retval -EINVAL If @p loops is out of range or the asset is corrupted.
+ * @retval -errno Other negative errno code on failure.
+ */
+int play_asset(const char *name, uint32_t loops, struct play_stats *stats);
+
+#endif /* APP_SRC_PLAY_H_ */
@@ -0,0 +1,196 @@
+#include "raster.h"
+
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Lines are processed in 32-bit words aligned to the start of the line, with
+ * masks for the words at both edges. Lines do not need to be a multiple of 4
+ * bytes long, so the last word of a line may be a partial one.
+ */
+
+static inline uint32_t raster_load(const uint8_t *p, uint16_t len)
+{
+	uint32_t val = 0U;
+
+	if (len >= 4U) {
+		memcpy(&val, p, 4U);
+		return sys_le32_to_cpu(val);
+	}
+
+	for (uint16_t i = 0U; i < len; i++) {
+		val |= (uint32_t)p[i] << (8U * i);
+	}
+
+	return val;
+}
+
+static inline void raster_store(uint8_t *p, uint16_t len, uint32_t val)
+{
+	if (len >= 4U) {
+		val = sys_cpu_to_le32(val);
+		memcpy(p, &val, 4U);
+		return;
+	}
+
+	for (uint16_t i = 0U; i < len; i++) {
+		p[i] = val >> (8U * i);
+	}
+}
+
+/* 32 pixels of a source line, starting at the given pixel */
+static inline uint32_t raster_fetch(const uint8_t *src, uint16_t len, uint32_t bit)
+{
+	uint16_t byte = bit / 8U;
+	uint32_t val;
+
+	if (byte >= len) {
+		return 0U;
+	}
+
+	val = raster_load(&src[byte], len - byte) >> (bit % 8U);
+	if (bit % 8U != 0U && byte + 4U < len) {
+		val |= (uint32_t)src[byte + 4U] << (32U - bit % 8U);
+	}
+
+	return val;
+}
+
+/*
+ * Apply an operation to pixels [x, x + w) of a line, using either a source
+ * line (src != NULL, its pixel 0 going to x) or a fill pattern.
+ */
+static void raster_span(const struct raster *r, uint8_t *line, uint16_t x, uint16_t w,
+			const uint8_t *src, uint16_t src_len, uint32_t pattern,
+			enum raster_rop rop)
+{
+	uint32_t end = x + w;
+
+	for (uint32_t base = ROUND_DOWN(x, 32U); base < end; base += 32U) {
+		uint8_t *p = &line[base / 8U];
+		uint16_t len = MIN(4U, r->pitch - base / 8U);
+		uint32_t mask = UINT32_MAX;
+		uint32_t val;
+
+		if (base < x) {
+			mask &= UINT32_MAX << (x - base);
+		}
+
+		if (end - base < 32U) {
+			mask &= UINT32_MAX >> (32U - (end - base));
+		}
+
+		if (src == NULL) {
+			val = pattern;
+		} else if (base < x) {
+			val = raster_fetch(src, src_len, 0U) << (x - base);
+		} else {
+			val = raster_fetch(src, src_len, base - x);
+		}
+
+		if (rop == RASTER_XOR) {
+			raster_store(p, len, raster_load(p, len) ^ (val & mask));
+		} else if (mask == UINT32_MAX) {
+			raster_store(p, len, val);
+		} else {
+			raster_store(p, len, (raster_load(p, len) & ~mask) | (val & mask));
+		}
+	}
+}
+
+static bool raster_clip(const struct raster *r, uint16_t x, uint16_t y, uint16_t *w,
+			uint16_t *h)
+{
+	if (x >= r->width || y >= r->height) {
+		return false;
+	}
+
+	*w = MIN(*w, r->width - x);
+	*h = MIN(*h, r->height - y);
+
+	return *w > 0U && *h > 0U;
+}
+
+static void raster_fill(const struct raster *r, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+			uint32_t pattern, enum raster_rop rop)
+{
+	if (!raster_clip(r, x, y, &w, &h)) {
+		return;
+	}
+
+	for (uint16_t line = y; line < y + h; line++) {
+		raster_span(r, &r->buf[line * r->pitch], x, w, NULL, 0U, pattern, rop);
+	}
+}
+
+void raster_fill_rect(const struct raster *r, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+		      enum raster_color color)
+{
+	switch (color) {
+	case RASTER_BLACK:
+		raster_fill(r, x, y, w, h, 0U, RASTER_COPY);
+		break;
+	case RASTER_WHITE:
+		raster_fill(r, x, y, w, h, UINT32_MAX, RASTER_COPY);
+		break;
+	case RASTER_INVERT:
+		raster_fill(r, x, y, w, h, UINT32_MAX, RASTER_XOR);
+		break;
+	}
+}
+
+void raster_fill_pattern(const struct raster *r, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+			 uint32_t pattern)
+{
+	raster_fill(r, x, y, w, h, pattern, RASTER_COPY);
+}
+
+void raster_hline(const struct raster *r, uint16_t x, uint16_t y, uint16_t w,
+		  enum raster_color color)
+{
+	raster_fill_rect(r, x, y, w, 1U, color);
+}
+
+void raster_vline(const struct raster *r, uint16_t x, uint16_t y, uint16_t h,
+		  enum raster_color color)
+{
+	uint16_t w = 1U;
+	uint8_t bit;
+
+	if (!raster_clip(r, x, y, &w, &h)) {
+		return;
+	}
+
+	bit = BIT(x % 8U);
+
+	for (uint8_t *p = &r->buf[y * r->pitch + x / 8U]; h > 0U; h--, p += r->pitch) {
+		switch (color) {
+		case RASTER_BLACK:
+			*p &= ~bit;
+			break;
+		case RASTER_WHITE:
+			*p |= bit;
+			break;
+		case RASTER_INVERT:
+			*p ^= bit;
+			break;
+		}
+	}
+}
+
+void raster_blit(const struct raster *r, uint16_t x, uint16_t y, const uint8_t *src,
+		 uint16_t src_pitch, uint16_t w, uint16_t h, enum raster_rop rop)
+{
+	uint16_t src_len = DIV_ROUND_UP(w, 8U);
+
+	if (!raster_clip(r, x, y, &w, &h)) {
+		return;
+	}
+
+	for (uint16_t line = 0U; line < h; line++) {
+		raster_span(r, &r->buf[(y + line) * r->pitch], x, w, &src[line * src_pitch],
+			    src_len, 0U, rop);
+	}
+}
@@ -0,0 +1,104 @@
+#ifndef APP_SRC_RASTER_H_
+#define APP_SRC_RASTER_H_
+
+#include <stdint.h>
+
+/**
+ * @brief 1 bpp raster.
+ *
+ * Pixels are packed with the leftmost one in the least significant bit, 1
+ * being white (PIXEL_FORMAT_MONO01). Drawing is clipped to the raster bounds.
+ */
+struct raster {
+	/** Pixel data. */
+	uint8_t *buf;
+	/** Width, in pixels. */
+	uint16_t width;
+	/** Height, in pixels. */
+	uint16_t height;
+	/** Line pitch, in bytes. */
+	uint16_t pitch;
+};
+
+/** @brief Fill colors. */
+enum raster_color {
+	RASTER_BLACK,
+	RASTER_WHITE,
+	/** Invert the existing pixels. */
+	RASTER_INVERT,
+};
+
+/** @brief Blit raster operations. */
+enum raster_rop {
+	/** Replace the existing pixels. */
+	RASTER_COPY,
+	/** XOR with the existing pixels. */
+	RASTER_XOR,
+};
+
+/**
+ * @brief Fill a rectangle.
+ *
+ * @param r Raster.
+ * @param x x coordinate of the upper left corner.
+ * @param y y coordinate of the upper left corner.
+ * @param w Width.
+ * @param h Height.
+ * @param color Fill color.
+ */
+void raster_fill_rect(const struct raster *r, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+		      enum raster_color color);
+
+/**
+ * @brief Fill a rectangle with a horizontal pattern.
+ *
+ * @param r Raster.
+ * @param x x coordinate of the upper left corner.
+ * @param y y coordinate of the upper left corner.
+ * @param w Width.
+ * @param h Height.
+ * @param pattern Pattern, bit n being used for pixels at columns n modulo 32.
+ */
+void raster_fill_pattern(const struct raster *r, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+			 uint32_t pattern);
+
+/**
+ * @brief Draw a horizontal line.
+ *
+ * @param r Raster.
+ * @param x x coordinate of the leftmost pixel.
+ * @param y y coordinate.
+ * @param w Width.
+ * @param color Line color.
+ */
+void raster_hline(const struct raster *r, uint16_t x, uint16_t y, uint16_t w,
+		  enum raster_color color);
+
+/**
+ * @brief Draw a vertical line.
+ *
+ * @param r Raster.
+ * @param x x coordinate.
+ * @param y y coordinate of the topmost pixel.
+ * @param h Height.
+ * @param color Line color.
+ */
+void raster_vline(const struct raster *r, uint16_t x, uint16_t y, uint16_t h,
+		  enum raster_color color);
+
+/**
+ * @brief Copy a 1 bpp image into the raster.
+ *
+ * @param r Raster.
+ * @param x x coordinate of the upper left corner, with no alignment constraint.
+ * @param y y coordinate of the upper left corner.
+ * @param src Image, in the same format as the raster, starting at bit 0.
+ * @param src_pitch Image line pitch, in bytes.
+ * @param w Image width.
+ * @param h Image height.
+ * @param rop Raster operation.
+ */
+void raster_blit(const struct raster *r, uint16_t x, uint16_t y, const uint8_t *src,
+		 uint16_t src_pitch, uint16_t w, uint16_t h, enum raster_rop rop);
+
+#endif /* APP_SRC_RASTER_H_ */
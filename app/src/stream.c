@@ -0,0 +1,221 @@
+#include "stream.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#define STREAM_DISPLAY DT_CHOSEN(zephyr_display)
+#define STREAM_WIDTH   DT_PROP(STREAM_DISPLAY, width)
+#define STREAM_HEIGHT  DT_PROP(STREAM_DISPLAY, height)
+
+/* packet types */
+#define STREAM_FULL  'F'
+#define STREAM_DELTA 'D'
+#define STREAM_END   'E'
+
+enum stream_state {
+	STREAM_TYPE,
+	STREAM_COUNT,
+	STREAM_LINE,
+	STREAM_DATA,
+};
+
+struct stream {
+	enum stream_state state;
+	uint8_t type;
+	/* buffer being received, the other one may be on its way to the panel */
+	uint8_t rx;
+	/* rx does not hold the last frame, line deltas need a copy first */
+	bool stale;
+	uint8_t lines;
+	uint8_t *dst;
+	size_t left;
+	uint32_t frames;
+	uint32_t shown;
+	uint32_t dropped;
+	uint32_t bytes;
+	int64_t start;
+	int err;
+};
+
+static const struct display_buffer_descriptor desc = {
+	.width = STREAM_WIDTH,
+	.height = STREAM_HEIGHT,
+	.pitch = STREAM_WIDTH,
+};
+
+static const struct device *display;
+static uint8_t buf[2][STREAM_HEIGHT][STREAM_WIDTH / 8];
+static struct stream stream;
+static atomic_t busy;
+static atomic_t errors;
+
+static void stream_done(const struct device *dev, int result, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	if (result < 0) {
+		atomic_inc(&errors);
+	}
+
+	atomic_clear(&busy);
+}
+
+/*
+ * A frame was fully received. It goes to the panel if the previous one is
+ * done, and reception moves on to the other buffer. Otherwise it is dropped,
+ * and the next frame overwrites it.
+ */
+static void stream_frame(void)
+{
+	int ret;
+
+	stream.frames++;
+
+	if (atomic_test_and_set_bit(&busy, 0)) {
+		stream.dropped++;
+		return;
+	}
+
+	ret = ls013b7dh05_write_async(display, 0, 0, &desc, buf[stream.rx], stream_done, NULL);
+	if (ret < 0) {
+		atomic_clear(&busy);
+		stream.err = ret;
+		return;
+	}
+
+	stream.shown++;
+	stream.rx ^= 1U;
+	stream.stale = true;
+}
+
+int stream_init(const struct device *disp)
+{
+	display = disp;
+
+	return 0;
+}
+
+int stream_start(void)
+{
+	int ret;
+
+	/* line deltas of the first frame apply to a white screen */
+	memset(buf, 0xff, sizeof(buf));
+	ret = display_write(display, 0, 0, &desc, buf[0]);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memset(&stream, 0, sizeof(stream));
+	stream.state = STREAM_TYPE;
+	atomic_clear(&busy);
+	atomic_clear(&errors);
+
+	return 0;
+}
+
+bool stream_feed(const uint8_t *data, size_t len)
+{
+	if (stream.bytes == 0U) {
+		stream.start = k_uptime_get();
+	}
+
+	stream.bytes += len;
+
+	while (len > 0U && stream.err == 0) {
+		size_t n;
+
+		switch (stream.state) {
+		case STREAM_TYPE:
+			stream.type = *data;
+			if (stream.type == STREAM_FULL) {
+				stream.dst = &buf[stream.rx][0][0];
+				stream.left = sizeof(buf[0]);
+				stream.stale = false;
+				stream.state = STREAM_DATA;
+			} else if (stream.type == STREAM_DELTA) {
+				if (stream.stale) {
+					memcpy(buf[stream.rx], buf[stream.rx ^ 1U], sizeof(buf[0]));
+					stream.stale = false;
+				}
+				stream.state = STREAM_COUNT;
+			} else if (stream.type == STREAM_END) {
+				return true;
+			} else {
+				stream.err = -EPROTO;
+			}
+			n = 1U;
+			break;
+		case STREAM_COUNT:
+			stream.lines = *data;
+			if (stream.lines == 0U) {
+				stream_frame();
+				stream.state = STREAM_TYPE;
+			} else {
+				stream.state = STREAM_LINE;
+			}
+			n = 1U;
+			break;
+		case STREAM_LINE:
+			if (*data >= STREAM_HEIGHT) {
+				stream.err = -EPROTO;
+			} else {
+				stream.dst = buf[stream.rx][*data];
+				stream.left = sizeof(buf[0][0]);
+				stream.state = STREAM_DATA;
+			}
+			n = 1U;
+			break;
+		case STREAM_DATA:
+			n = MIN(len, stream.left);
+			memcpy(stream.dst, data, n);
+			stream.dst += n;
+			stream.left -= n;
+			if (stream.left > 0U) {
+				break;
+			}
+
+			if (stream.type == STREAM_DELTA && --stream.lines > 0U) {
+				stream.state = STREAM_LINE;
+			} else {
+				stream_frame();
+				stream.state = STREAM_TYPE;
+			}
+			break;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	/* the rest of the stream is garbage */
+	return stream.err < 0;
+}
+
+int stream_stop(struct stream_stats *stats)
+{
+	int ret;
+
+	ret = ls013b7dh05_wait(display, K_MSEC(100));
+	if (ret < 0 && stream.err == 0) {
+		stream.err = ret;
+	}
+
+	stats->frames = stream.frames;
+	stats->shown = stream.shown;
+	stats->dropped = stream.dropped;
+	stats->errors = atomic_get(&errors);
+	stats->bytes = stream.bytes;
+	stats->elapsed_ms = (stream.bytes > 0U) ? k_uptime_get() - stream.start : 0U;
+
+	return stream.err;
+}
@@ -0,0 +1,78 @@
+#ifndef APP_SRC_STREAM_H_
+#define APP_SRC_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/** @brief Frame stream statistics. */
+struct stream_stats {
+	/** Number of frames received. */
+	uint32_t frames;
+	/** Number of frames sent to the panel. */
+	uint32_t shown;
+	/** Number of frames dropped, the previous one still being sent. */
+	uint32_t dropped;
+	/** Number of failed writes. */
+	uint32_t errors;
+	/** Number of bytes received. */
+	uint32_t bytes;
+	/** Time from the first byte received to the end of the stream, in milliseconds. */
+	uint32_t elapsed_ms;
+};
+
+/**
+ * @brief Initialize frame streaming.
+ *
+ * @param disp Display device.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int stream_init(const struct device *disp);
+
+/**
+ * @brief Start receiving a frame stream.
+ *
+ * The panel is cleared to white, which line deltas of the first frame apply
+ * to. Frames are received in turn into two buffers: a complete frame is sent
+ * asynchronously if the previous one is done, and is dropped otherwise.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code on failure.
+ */
+int stream_start(void);
+
+/**
+ * @brief Feed received bytes.
+ *
+ * Packets are a type byte followed by:
+ * - 'F': a full frame, height lines of width / 8 bytes, in the display format
+ * - 'D': a line count, then for each line its 0-based index and its data,
+ *   applied to the previous frame
+ * - 'E': nothing, ends the stream
+ *
+ * @param data Received bytes.
+ * @param len Number of bytes.
+ *
+ * @return true if the stream ended or failed, and the rest of the data must
+ * not be fed, false otherwise.
+ */
+bool stream_feed(const uint8_t *data, size_t len);
+
+/**
+ * @brief Stop receiving the frame stream.
+ *
+ * Waits for the last frame to be sent.
+ *
+ * @param stats Where to store the statistics.
+ *
+ * @retval 0 on success.
+ * @retval -EPROTO If a packet was malformed.
+ * @retval -errno Other negative errno code if a frame could not be sent.
+ */
+int stream_stop(struct stream_stats *stats);
+
+#endif /* APP_SRC_STREAM_H_ */
@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/timing/timing.h>
+
+#include <lvgl.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#include "ui.h"
+
+#define UI_FRAMES_MAX 1000U
+
+/* I1 buffers start with a 2 entry ARGB8888 palette */
+#define UI_PALETTE_SIZE 8U
+
+struct ui_stats {
+	uint32_t flushes;
+	uint32_t lines;
+	uint32_t errors;
+	/* in timing cycles */
+	uint64_t flush;
+};
+
+static const struct device *const disp = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+static lv_display_t *display;
+static lv_obj_t *counter;
+static lv_obj_t *bar;
+static uint32_t count;
+static struct ui_stats stats;
+static bool initialized;
+
+static inline uint8_t ui_reverse(uint8_t byte)
+{
+	byte = ((byte & 0x55U) << 1) | ((byte & 0xaaU) >> 1);
+	byte = ((byte & 0x33U) << 2) | ((byte & 0xccU) >> 2);
+
+	return (byte << 4) | (byte >> 4);
+}
+
+/* the panel is written one full line at a time, widen invalidated areas */
+static void ui_rounder(lv_event_t *e)
+{
+	lv_area_t *area = lv_event_get_param(e);
+
+	area->x1 = 0;
+	area->x2 = lv_display_get_horizontal_resolution(display) - 1;
+}
+
+static void ui_flush(lv_display_t *d, const lv_area_t *area, uint8_t *px_map)
+{
+	uint32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), LV_COLOR_FORMAT_I1);
+	struct display_buffer_descriptor desc = {
+		.width = lv_area_get_width(area),
+		.height = lv_area_get_height(area),
+		.pitch = stride * 8U,
+	};
+	timing_t start, end;
+	int ret;
+
+	start = timing_counter_get();
+
+	px_map += UI_PALETTE_SIZE;
+	desc.buf_size = stride * desc.height;
+
+	/*
+	 * LVGL renders 1 for light pixels like the panel, but with the leftmost
+	 * pixel in the most significant bit. The band is converted in place and
+	 * written as is, so that only the invalidated lines go out.
+	 */
+	for (uint32_t i = 0U; i < desc.buf_size; i++) {
+		px_map[i] = ui_reverse(px_map[i]);
+	}
+
+	ret = display_write(disp, area->x1, area->y1, &desc, px_map);
+
+	end = timing_counter_get();
+
+	stats.flushes++;
+	if (ret < 0) {
+		stats.errors++;
+	} else {
+		stats.lines += desc.height;
+	}
+	stats.flush += timing_cycles_get(&start, &end);
+
+	lv_display_flush_ready(d);
+}
+
+static void ui_update(void)
+{
+	lv_label_set_text_fmt(counter, "%u", count);
+	lv_bar_set_value(bar, count % 100U, LV_ANIM_OFF);
+	count++;
+}
+
+static int cmd_ui_show(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!initialized) {
+		shell_error(sh, "UI module not initialized");
+		return -EPERM;
+	}
+
+	/* other display commands draw behind LVGL's back */
+	lv_obj_invalidate(lv_screen_active());
+	lv_refr_now(display);
+
+	return 0;
+}
+
+static int cmd_ui_bench(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const names[] = {"full", "area"};
+	uint32_t frames = 100U;
+
+	if (!initialized) {
+		shell_error(sh, "UI module not initialized");
+		return -EPERM;
+	}
+
+	if (argc > 1) {
+		frames = strtoul(argv[1], NULL, 0);
+		if (frames == 0U || frames > UI_FRAMES_MAX) {
+			shell_error(sh, "Invalid number of frames (1-%u)", UI_FRAMES_MAX);
+			return -EINVAL;
+		}
+	}
+
+	timing_init();
+	timing_start();
+
+	/* same content change in both cases, the full redraw also invalidates the screen */
+	for (size_t kind = 0U; kind < ARRAY_SIZE(names); kind++) {
+		struct ls013b7dh05_stats before, after;
+		timing_t start, end;
+		uint64_t total_us, flush_us;
+
+		lv_obj_invalidate(lv_screen_active());
+		lv_refr_now(display);
+
+		memset(&stats, 0, sizeof(stats));
+		ls013b7dh05_get_stats(disp, &before);
+
+		start = timing_counter_get();
+
+		for (uint32_t frame = 0U; frame < frames; frame++) {
+			ui_update();
+			if (kind == 0U) {
+				lv_obj_invalidate(lv_screen_active());
+			}
+			lv_refr_now(display);
+		}
+
+		end = timing_counter_get();
+
+		ls013b7dh05_get_stats(disp, &after);
+
+		total_us = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC;
+		flush_us = timing_cycles_to_ns(stats.flush) / NSEC_PER_USEC;
+
+		shell_print(sh, "%s: %llu us/frame (render %llu us, flush %llu us)", names[kind],
+			    total_us / frames, (total_us - flush_us) / frames, flush_us / frames);
+		shell_print(sh, "%s: %u flushes, %u lines, %llu bytes sent per frame", names[kind],
+			    stats.flushes / frames, stats.lines / frames,
+			    (after.bytes_sent - before.bytes_sent) / frames);
+
+		if (stats.errors > 0U) {
+			shell_error(sh, "%u failed flushes", stats.errors);
+		}
+	}
+
+	timing_stop();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_ui_cmds, SHELL_CMD(show, NULL, "Show LVGL screen", cmd_ui_show),
+	SHELL_CMD_ARG(bench, NULL, "Compare full and invalidated area redraws: bench [FRAMES]",
+		      cmd_ui_bench, 1, 1),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((hwv), ui, &sub_ui_cmds, "LVGL UI", NULL, 0, 0);
+
+int ui_init(void)
+{
+	lv_obj_t *scr;
+	lv_obj_t *title;
+
+	if (!device_is_ready(disp)) {
+		return -ENODEV;
+	}
+
+	display = lv_display_get_default();
+	if (display == NULL) {
+		return -ENODEV;
+	}
+
+	if (lv_display_get_color_format(display) != LV_COLOR_FORMAT_I1) {
+		return -ENOTSUP;
+	}
+
+	lv_display_set_flush_cb(display, ui_flush);
+	lv_display_add_event_cb(display, ui_rounder, LV_EVENT_INVALIDATE_AREA, NULL);
+
+	scr = lv_screen_active();
+	lv_obj_set_style_bg_color(scr, lv_color_white(), LV_PART_MAIN);
+	lv_obj_set_style_text_color(scr, lv_color_black(), LV_PART_MAIN);
+
+	title = lv_label_create(scr);
+	lv_label_set_text(title, "HWV");
+	lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 4);
+
+	counter = lv_label_create(scr);
+	lv_obj_set_style_text_font(counter, &lv_font_montserrat_28, LV_PART_MAIN);
+	lv_obj_align(counter, LV_ALIGN_CENTER, 0, 0);
+
+	bar = lv_bar_create(scr);
+	lv_obj_set_size(bar, lv_pct(80), 12);
+	lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -8);
+	lv_obj_set_style_bg_color(bar, lv_color_white(), LV_PART_MAIN);
+	lv_obj_set_style_border_color(bar, lv_color_black(), LV_PART_MAIN);
+	lv_obj_set_style_border_width(bar, 1, LV_PART_MAIN);
+	lv_obj_set_style_bg_color(bar, lv_color_black(), LV_PART_INDICATOR);
+
+	ui_update();
+
+	initialized = true;
+
+	return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef APP_SRC_UI_H_
+#define APP_SRC_UI_H_
+
+int ui_init(void);
+
+#endif /* APP_SRC_UI_H_ */
@@ -5,11 +5,21 @@
 #include <zephyr/drivers/led.h>
 #include <zephyr/drivers/pwm.h>
 #include <zephyr/drivers/spi.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <hwv/drivers/display/ls013b7dh05.h>
 
 LOG_MODULE_REGISTER(ls013b7dh05, CONFIG_DISPLAY_LOG_LEVEL);
 
 #define LS013B7DH05_WRITE BIT(0)
+#define LS013B7DH05_VCOM  BIT(1)
+#define LS013B7DH05_CLEAR BIT(2)
+
+#define LS013B7DH05_VCOM_RETRY_MS 5U
 
 struct ls013b7dh05_config {
 	struct spi_dt_spec spi;
@@ -19,10 +29,152 @@ struct ls013b7dh05_config {
 	uint8_t width;
 	uint8_t height;
 	uint8_t line_width;
+	bool serial_vcom;
+	uint16_t vcom_period_ms;
+	uint16_t min_vcom_period_ms;
+	uint16_t hold_vcom_period_ms;
 	uint8_t *fb;
 	uint32_t fb_size;
+	uint8_t fb_count;
+	uint8_t (*hdr)[2];
+	/* lines to send on the next write covering them */
+	atomic_t *dirty;
+	struct spi_buf *bufs;
+};
+
+struct ls013b7dh05_data {
+	const struct device *dev;
+	struct k_sem lock;
+	struct spi_buf_set sbufs;
+	uint8_t cmd;
+	uint8_t trailer[2];
+	uint8_t mode[2];
+	uint8_t vcom;
+	bool vcom_on;
+	uint16_t vcom_period_ms;
+	/* period to restore when leaving hold mode */
+	uint16_t run_vcom_period_ms;
+	bool held;
+	uint32_t vcom_toggled;
+	struct k_work_delayable vcom_work;
+	uint16_t pending;
+	uint8_t back;
+	/* back buffer handed out by display_get_framebuffer() */
+	bool lent;
+	uint8_t top;
+	enum display_orientation orientation;
+	int result;
+#ifdef CONFIG_LS013B7DH05_ASYNC
+	ls013b7dh05_callback_t cb;
+	void *user_data;
+#endif
+	struct ls013b7dh05_stats stats;
 };
 
+static void ls013b7dh05_vcom_toggle(const struct device *dev)
+{
+	struct ls013b7dh05_data *data = dev->data;
+
+	data->vcom ^= LS013B7DH05_VCOM;
+	data->vcom_toggled = k_uptime_get_32();
+}
+
+/*
+ * In serial mode VCOM is inverted through the M1 bit of the command byte.
+ * Writes toggle it when due, so the "display mode" command is only sent while
+ * the image is static.
+ */
+static void ls013b7dh05_vcom_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ls013b7dh05_data *data = CONTAINER_OF(dwork, struct ls013b7dh05_data, vcom_work);
+	const struct device *dev = data->dev;
+	const struct ls013b7dh05_config *config = dev->config;
+	struct spi_buf sbuf = {.buf = data->mode, .len = sizeof(data->mode)};
+	struct spi_buf_set sbufs = {.buffers = &sbuf, .count = 1U};
+	uint32_t elapsed;
+	int ret;
+
+	/* do not block the work queue while a write is in progress */
+	if (k_sem_take(&data->lock, K_NO_WAIT) < 0) {
+		(void)k_work_reschedule(dwork, K_MSEC(LS013B7DH05_VCOM_RETRY_MS));
+		return;
+	}
+
+	elapsed = k_uptime_get_32() - data->vcom_toggled;
+	if (elapsed < data->vcom_period_ms) {
+		k_sem_give(&data->lock);
+		(void)k_work_reschedule(dwork, K_MSEC(data->vcom_period_ms - elapsed));
+		return;
+	}
+
+	ls013b7dh05_vcom_toggle(dev);
+
+	data->mode[0] = data->vcom;
+	data->mode[1] = 0U;
+
+	/* in hold mode the SPI bus only wakes up for the inversion */
+	if (IS_ENABLED(CONFIG_PM_DEVICE) && data->held) {
+		(void)pm_device_action_run(config->spi.bus, PM_DEVICE_ACTION_RESUME);
+	}
+
+	ret = spi_write_dt(&config->spi, &sbufs);
+	if (ret < 0) {
+		LOG_ERR("Failed to toggle VCOM (%d)", ret);
+	}
+
+	if (IS_ENABLED(CONFIG_PM_DEVICE) && data->held) {
+		(void)pm_device_action_run(config->spi.bus, PM_DEVICE_ACTION_SUSPEND);
+	}
+
+	k_sem_give(&data->lock);
+
+	(void)k_work_reschedule(dwork, K_MSEC(data->vcom_period_ms));
+}
+
+/* EXTCOMIN rising edges invert VCOM, so the PWM period is the inversion period */
+static int ls013b7dh05_extcomin_set(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	if (data->vcom_period_ms == 0U) {
+		return pwm_set_pulse_dt(&config->extcomin, PWM_USEC(100));
+	}
+
+	return pwm_set_dt(&config->extcomin, PWM_MSEC(data->vcom_period_ms), PWM_USEC(100));
+}
+
+static int ls013b7dh05_vcom_start(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	data->vcom_on = true;
+
+	if (config->serial_vcom) {
+		(void)k_work_reschedule(&data->vcom_work, K_MSEC(data->vcom_period_ms));
+		return 0;
+	}
+
+	return ls013b7dh05_extcomin_set(dev);
+}
+
+static int ls013b7dh05_vcom_stop(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	data->vcom_on = false;
+
+	if (config->serial_vcom) {
+		(void)k_work_cancel_delayable(&data->vcom_work);
+		return 0;
+	}
+
+	return pwm_set_pulse_dt(&config->extcomin, 0U);
+}
+
 static int ls013b7dh05_blanking_on(const struct device *dev)
 {
 	const struct ls013b7dh05_config *config = dev->config;
@@ -33,7 +185,7 @@ static int ls013b7dh05_blanking_on(const struct device *dev)
 		return ret;
 	}
 
-	ret = pwm_set_pulse_dt(&config->extcomin, 0U);
+	ret = ls013b7dh05_vcom_stop(dev);
 	if (ret < 0) {
 		return ret;
 	}
@@ -49,14 +201,20 @@ static int ls013b7dh05_blanking_on(const struct device *dev)
 static int ls013b7dh05_blanking_off(const struct device *dev)
 {
 	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
 	int ret;
 
+	/* hold mode keeps the backlight off */
+	if (data->held) {
+		return -EPERM;
+	}
+
 	ret = gpio_pin_set_dt(&config->disp, 1);
 	if (ret < 0) {
 		return ret;
 	}
 
-	ret = pwm_set_pulse_dt(&config->extcomin, PWM_USEC(100));
+	ret = ls013b7dh05_vcom_start(dev);
 	if (ret < 0) {
 		return ret;
 	}
@@ -69,57 +227,468 @@ static int ls013b7dh05_blanking_off(const struct device *dev)
 	return 0;
 }
 
+static void ls013b7dh05_mark(const struct device *dev, uint16_t line, uint16_t count)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+
+	for (uint16_t i = 0U; i < count; i++) {
+		atomic_set_bit(config->dirty, line + i);
+	}
+}
+
+/*
+ * Without double buffering, the framebuffer handed out is the one shadowing
+ * the panel, and is changed in place: the lines handed out are sent by the
+ * next write covering them. A back buffer is compared with the front one
+ * instead when it is written.
+ */
 static void *ls013b7dh05_get_framebuffer(const struct device *dev)
 {
 	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	if (config->fb_count == 1U) {
+		ls013b7dh05_mark(dev, 0U, config->height);
+	} else {
+		data->lent = true;
+	}
 
-	return config->fb;
+	return &config->fb[data->back * config->fb_size];
 }
 
-static int ls013b7dh05_write(const struct device *dev, uint16_t x, uint16_t y,
-			     const struct display_buffer_descriptor *desc, const void *buf)
+static inline uint8_t ls013b7dh05_reverse(uint8_t byte)
+{
+	byte = ((byte & 0x55U) << 1) | ((byte & 0xaaU) >> 1);
+	byte = ((byte & 0x33U) << 2) | ((byte & 0xccU) >> 2);
+
+	return (byte << 4) | (byte >> 4);
+}
+
+/*
+ * Transpose an 8x8 bit matrix, bit c of byte r moving to bit r of byte c. The
+ * rows are packed in two words, and bits are swapped with their mirror in
+ * 2x2, then 4x4 blocks, and nibbles across the words for the 8x8 step.
+ */
+static void ls013b7dh05_transpose(uint8_t m[8])
+{
+	uint32_t lo = sys_get_le32(&m[0]);
+	uint32_t hi = sys_get_le32(&m[4]);
+	uint32_t t;
+
+	t = (lo ^ (lo >> 7)) & 0x00aa00aaU;
+	lo ^= t ^ (t << 7);
+	t = (hi ^ (hi >> 7)) & 0x00aa00aaU;
+	hi ^= t ^ (t << 7);
+
+	t = (lo ^ (lo >> 14)) & 0x0000ccccU;
+	lo ^= t ^ (t << 14);
+	t = (hi ^ (hi >> 14)) & 0x0000ccccU;
+	hi ^= t ^ (t << 14);
+
+	t = (lo & 0x0f0f0f0fU) | ((hi << 4) & 0xf0f0f0f0U);
+	hi = ((lo >> 4) & 0x0f0f0f0fU) | (hi & 0xf0f0f0f0U);
+	lo = t;
+
+	sys_put_le32(lo, &m[0]);
+	sys_put_le32(hi, &m[4]);
+}
+
+/*
+ * Merge a row of w pixels into a line at pixel x. Each destination byte takes
+ * the source bits shifted into place, masked to the pixels of the rectangle.
+ * Returns whether any pixel changed.
+ */
+static bool ls013b7dh05_merge(uint8_t *dst, const uint8_t *src, uint16_t x, uint16_t w)
+{
+	uint16_t src_len = DIV_ROUND_UP(w, 8U);
+	uint8_t diff = 0U;
+
+	for (uint16_t i = x / 8U; i <= (x + w - 1U) / 8U; i++) {
+		int32_t bit = i * 8 - x;
+		uint8_t lo = MAX(x, i * 8U) - i * 8U;
+		uint8_t hi = MIN(x + w, i * 8U + 8U) - i * 8U;
+		uint8_t mask = GENMASK(hi - 1U, lo);
+		uint16_t val;
+
+		if (bit < 0) {
+			val = src[0] << -bit;
+		} else {
+			val = src[bit / 8];
+			if (bit / 8 + 1 < src_len) {
+				val |= src[bit / 8 + 1] << 8;
+			}
+			val >>= bit % 8;
+		}
+
+		diff |= (dst[i] ^ val) & mask;
+		dst[i] = (dst[i] & ~mask) | (val & mask);
+	}
+
+	return diff != 0U;
+}
+
+static inline uint8_t *ls013b7dh05_shadow(const struct device *dev, uint8_t *front, uint16_t line)
 {
 	const struct ls013b7dh05_config *config = dev->config;
-	struct spi_buf sbuf;
-	struct spi_buf_set sbufs = {.buffers = &sbuf, .count = 1U};
-	int ret;
+	struct ls013b7dh05_data *data = dev->data;
+
+	return &front[((line + data->top) % config->height) * config->line_width];
+}
+
+/*
+ * Rotate a rectangle into the shadow framebuffer, and report the panel lines
+ * it covers, marking the ones that changed. At 180 degrees, lines are
+ * mirrored a byte at a time. At 90 and 270 degrees, the rectangle is split in
+ * 8x8 blocks, which are transposed so that each source column becomes a byte
+ * of a panel line.
+ */
+static void ls013b7dh05_rotate(const struct device *dev, uint8_t *front, uint16_t x, uint16_t y,
+			       const struct display_buffer_descriptor *desc, const uint8_t *buf,
+			       uint16_t *first, uint16_t *count)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	uint16_t pitch = DIV_ROUND_UP(desc->pitch, 8U);
+	uint16_t len = DIV_ROUND_UP(desc->width, 8U);
+	bool cw = (data->orientation == DISPLAY_ORIENTATION_ROTATED_90);
+
+	if (data->orientation == DISPLAY_ORIENTATION_ROTATED_180) {
+		*first = config->height - y - desc->height;
+		*count = desc->height;
+
+		for (uint16_t j = 0U; j < desc->height; j++) {
+			uint16_t line = config->height - 1U - y - j;
+			uint8_t *dst = ls013b7dh05_shadow(dev, front, line);
+
+			for (uint16_t k = 0U; k < len; k++) {
+				uint8_t n = MIN(8U, desc->width - k * 8U);
+				uint8_t val = ls013b7dh05_reverse(buf[j * pitch + k]) >> (8U - n);
+
+				if (ls013b7dh05_merge(dst, &val, config->width - x - k * 8U - n, n)) {
+					atomic_set_bit(config->dirty, line);
+				}
+			}
+		}
+
+		return;
+	}
+
+	*first = cw ? x : config->height - x - desc->width;
+	*count = desc->width;
+
+	for (uint16_t by = 0U; by < desc->height; by += 8U) {
+		uint8_t n = MIN(8U, desc->height - by);
+
+		for (uint16_t k = 0U; k < len; k++) {
+			uint8_t m[8] = {0};
+
+			for (uint8_t r = 0U; r < n; r++) {
+				m[r] = buf[(by + r) * pitch + k];
+			}
+
+			ls013b7dh05_transpose(m);
+
+			for (uint8_t c = 0U; c < MIN(8U, desc->width - k * 8U); c++) {
+				uint16_t col = x + k * 8U + c;
+				uint16_t line = cw ? col : config->height - 1U - col;
+				uint8_t *dst = ls013b7dh05_shadow(dev, front, line);
+				uint8_t val;
+				bool changed;
+
+				/* source rows run right to left at 90 degrees */
+				if (cw) {
+					val = ls013b7dh05_reverse(m[c]) >> (8U - n);
+					changed = ls013b7dh05_merge(dst, &val,
+								    config->width - y - by - n, n);
+				} else {
+					val = m[c];
+					changed = ls013b7dh05_merge(dst, &val, y + by, n);
+				}
+
+				if (changed) {
+					atomic_set_bit(config->dirty, line);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Build the transfer for the lines in the given area that changed since they
+ * were last sent, or that are marked as dirty. Returns the number of lines to
+ * be sent, or a negative errno code on failure. Must be called with the lock
+ * held.
+ *
+ * Line data is sent straight from the given buffer: the command, the line
+ * addresses and the dummy bytes trailing each line go in buffers of their
+ * own, so the whole transfer is described by a single buffer set. Writes
+ * from anywhere in the front framebuffer take the lines of the area from the
+ * scrolling ring, so that a band located with ls013b7dh05_get_line() can
+ * cross the end of the ring.
+ *
+ * The front framebuffer shadows the panel contents: lines written from other
+ * buffers are compared with it and copied into it when they differ, and
+ * rectangles narrower than the panel or not in the normal orientation are
+ * merged into it, the affected lines being sent from there. Lines changed in
+ * place in the front framebuffer cannot be compared, and are only sent when
+ * marked as dirty.
+ */
+static int ls013b7dh05_prepare(const struct device *dev, uint16_t x, uint16_t y,
+			       const struct display_buffer_descriptor *desc, const void *buf)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	struct spi_buf_set *sbufs = &data->sbufs;
+	struct spi_buf *sbuf = config->bufs;
+	uint16_t pitch = DIV_ROUND_UP(desc->pitch, 8U);
+	uint16_t sent = 0U;
 	const uint8_t *pbuf = buf;
+	bool rotated = (data->orientation != DISPLAY_ORIENTATION_NORMAL);
+	bool swapped = (data->orientation == DISPLAY_ORIENTATION_ROTATED_90 ||
+			data->orientation == DISPLAY_ORIENTATION_ROTATED_270);
+	uint16_t width = swapped ? config->height : config->width;
+	uint16_t height = swapped ? config->width : config->height;
+	bool partial = (x != 0U || desc->width != width);
+	uint16_t first = y;
+	uint16_t count = desc->height;
+	uint8_t *front;
+	const uint8_t *prev = NULL;
+	bool in_front;
 
-	if (buf != config->fb) {
-		LOG_ERR("Unsupported buffer");
-		return -EINVAL;
+	if (data->held) {
+		LOG_ERR("Display in hold mode");
+		return -EPERM;
 	}
 
-	if (x != 0U || desc->height == 0U || y + desc->height > config->height) {
+	if (desc->width == 0U || x + desc->width > width || desc->pitch < desc->width ||
+	    desc->height == 0U || y + desc->height > height) {
 		LOG_ERR("Unsupported position");
 		return -EINVAL;
 	}
 
-	uint8_t init[2] = {LS013B7DH05_WRITE, y + 1U};
-	sbuf.buf = init;
-	sbuf.len = 2U;
-	ret = spi_write_dt(&config->spi, &sbufs);
-	if (ret < 0) {
-		goto release;
+	/* the framebuffer holds the panel contents, in the normal orientation */
+	if (rotated && pbuf >= config->fb &&
+	    pbuf < &config->fb[config->fb_size * config->fb_count]) {
+		LOG_ERR("Framebuffer writes need the normal orientation");
+		return -EINVAL;
 	}
 
-	sbuf.buf = (void *)&pbuf[y * desc->pitch / 8U];
-	sbuf.len = desc->height * desc->pitch / 8U - 1U;
-	ret = spi_write_dt(&config->spi, &sbufs);
+	/*
+	 * With double buffering, handing the back buffer over to the display
+	 * turns it into the front buffer, and the previous front buffer
+	 * becomes the one to render the next frame into. Only the buffer
+	 * returned by display_get_framebuffer() is handed over: bands located
+	 * with ls013b7dh05_get_line() are compared and copied, so that the back
+	 * buffer can hold a frame being updated in place.
+	 */
+	if (config->fb_count > 1U && data->lent &&
+	    pbuf == &config->fb[data->back * config->fb_size]) {
+		data->lent = false;
+		prev = &config->fb[((data->back + config->fb_count - 1U) % config->fb_count) *
+				   config->fb_size];
+		data->back = (data->back + 1U) % config->fb_count;
+	}
+
+	front = &config->fb[((data->back + config->fb_count - 1U) % config->fb_count) *
+			    config->fb_size];
+	in_front = (pbuf >= front && pbuf < &front[config->fb_size]);
+
+	if (rotated) {
+		ls013b7dh05_rotate(dev, front, x, y, desc, pbuf, &first, &count);
+	}
+
+	sbuf->buf = &data->cmd;
+	sbuf->len = 1U;
+	sbuf++;
+
+	for (uint16_t i = 0U; i < count; i++) {
+		uint16_t line = first + i;
+		uint8_t *shadow = ls013b7dh05_shadow(dev, front, line);
+		const uint8_t *pline;
+		bool changed = false;
+
+		if (rotated) {
+			pline = shadow;
+		} else if (partial) {
+			changed = ls013b7dh05_merge(shadow, &pbuf[i * pitch], x, desc->width);
+			pline = shadow;
+		} else if (prev != NULL) {
+			/* no scrolling with double buffering, lines are in order */
+			pline = shadow;
+			changed = memcmp(&prev[line * config->line_width], pline,
+					 config->line_width) != 0;
+		} else if (in_front) {
+			pline = shadow;
+		} else {
+			pline = &pbuf[i * pitch];
+			changed = memcmp(shadow, pline, config->line_width) != 0;
+			if (changed) {
+				memcpy(shadow, pline, config->line_width);
+			}
+		}
+
+		if (!atomic_test_and_clear_bit(config->dirty, line) && !changed) {
+			continue;
+		}
+
+		/* the first line has no previous line to trail */
+		sbuf->buf = &config->hdr[line][(sent == 0U) ? 1U : 0U];
+		sbuf->len = (sent == 0U) ? 1U : 2U;
+		sbuf++;
+
+		sbuf->buf = (void *)pline;
+		sbuf->len = config->line_width;
+		sbuf++;
+
+		sent++;
+	}
+
+	data->stats.flushes++;
+	data->stats.lines_skipped += count - sent;
+	data->stats.bytes_saved += (count - sent) * (config->line_width + 2U) +
+				   ((sent == 0U) ? 2U : 0U);
+
+	data->pending = sent;
+	data->result = 0;
+
+	if (sent == 0U) {
+		return 0;
+	}
+
+	if (config->serial_vcom &&
+	    k_uptime_get_32() - data->vcom_toggled >= data->vcom_period_ms) {
+		ls013b7dh05_vcom_toggle(dev);
+	}
+
+	data->cmd = LS013B7DH05_WRITE | data->vcom;
+
+	sbuf->buf = data->trailer;
+	sbuf->len = sizeof(data->trailer);
+	sbuf++;
+
+	sbufs->buffers = config->bufs;
+	sbufs->count = sbuf - config->bufs;
+
+	return sent;
+}
+
+static void ls013b7dh05_complete(const struct device *dev, int result)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	data->result = result;
+
+	if (result < 0) {
+		ls013b7dh05_invalidate(dev);
+		return;
+	}
+
+	data->stats.transactions++;
+	data->stats.lines_sent += data->pending;
+	data->stats.bytes_sent += data->pending * (config->line_width + 2U) + 2U;
+}
+
+static int ls013b7dh05_write(const struct device *dev, uint16_t x, uint16_t y,
+			     const struct display_buffer_descriptor *desc, const void *buf)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	ret = ls013b7dh05_prepare(dev, x, y, desc, buf);
+	if (ret > 0) {
+		ret = spi_write_dt(&config->spi, &data->sbufs);
+		ls013b7dh05_complete(dev, ret);
+	}
+
+	k_sem_give(&data->lock);
+
+	return MIN(ret, 0);
+}
+
+#ifdef CONFIG_LS013B7DH05_ASYNC
+static void ls013b7dh05_spi_cb(const struct device *spi, int result, void *user_data)
+{
+	const struct device *dev = user_data;
+	struct ls013b7dh05_data *data = dev->data;
+	ls013b7dh05_callback_t cb = data->cb;
+	void *cb_user_data = data->user_data;
+
+	ARG_UNUSED(spi);
+
+	ls013b7dh05_complete(dev, result);
+
+	k_sem_give(&data->lock);
+
+	if (cb != NULL) {
+		cb(dev, result, cb_user_data);
+	}
+}
+#endif /* CONFIG_LS013B7DH05_ASYNC */
+
+int ls013b7dh05_write_async(const struct device *dev, uint16_t x, uint16_t y,
+			    const struct display_buffer_descriptor *desc, const void *buf,
+			    ls013b7dh05_callback_t cb, void *user_data)
+{
+#ifdef CONFIG_LS013B7DH05_ASYNC
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	ret = ls013b7dh05_prepare(dev, x, y, desc, buf);
+	if (ret <= 0) {
+		k_sem_give(&data->lock);
+
+		if (ret == 0 && cb != NULL) {
+			cb(dev, 0, user_data);
+		}
+
+		return ret;
+	}
+
+	data->cb = cb;
+	data->user_data = user_data;
+
+	ret = spi_transceive_cb(config->spi.bus, &config->spi.config, &data->sbufs, NULL,
+				ls013b7dh05_spi_cb, (void *)dev);
 	if (ret < 0) {
-		goto release;
+		ls013b7dh05_complete(dev, ret);
+		k_sem_give(&data->lock);
+		return ret;
 	}
 
-	uint8_t end = 0U;
-	sbuf.buf = &end;
-	sbuf.len = 1U;
-	ret = spi_write_dt(&config->spi, &sbufs);
+	return 0;
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(x);
+	ARG_UNUSED(y);
+	ARG_UNUSED(desc);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+#endif /* CONFIG_LS013B7DH05_ASYNC */
+}
+
+int ls013b7dh05_wait(const struct device *dev, k_timeout_t timeout)
+{
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	ret = k_sem_take(&data->lock, timeout);
 	if (ret < 0) {
-		goto release;
+		return ret;
 	}
 
-release:
-	(void)spi_release_dt(&config->spi);
+	ret = data->result;
+
+	k_sem_give(&data->lock);
 
 	return ret;
 }
@@ -127,9 +696,12 @@ release:
 static int ls013b7dh05_set_brightness(const struct device *dev, uint8_t brightness)
 {
 	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
 
 	if (brightness == 0U) {
 		return led_off(config->backlight, 0);
+	} else if (data->held) {
+		return -EPERM;
 	} else {
 		int ret;
 
@@ -146,27 +718,54 @@ static void ls013b7dh05_get_capabilities(const struct device *dev,
 					 struct display_capabilities *capabilities)
 {
 	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	bool swapped = (data->orientation == DISPLAY_ORIENTATION_ROTATED_90 ||
+			data->orientation == DISPLAY_ORIENTATION_ROTATED_270);
 
 	memset(capabilities, 0, sizeof(*capabilities));
 
-	capabilities->x_resolution = config->width;
-	capabilities->y_resolution = config->height;
+	capabilities->x_resolution = swapped ? config->height : config->width;
+	capabilities->y_resolution = swapped ? config->width : config->height;
 	capabilities->supported_pixel_formats = PIXEL_FORMAT_MONO01;
 	capabilities->current_pixel_format = PIXEL_FORMAT_MONO01;
-	capabilities->current_orientation = 0;
+	capabilities->current_orientation = data->orientation;
+}
+
+static int ls013b7dh05_set_orientation(const struct device *dev,
+				       const enum display_orientation orientation)
+{
+	struct ls013b7dh05_data *data = dev->data;
+
+	if (orientation > DISPLAY_ORIENTATION_ROTATED_270) {
+		return -EINVAL;
+	}
+
+	/* wait for a transfer in progress, which may come from the shadow framebuffer */
+	(void)k_sem_take(&data->lock, K_FOREVER);
+	data->orientation = orientation;
+	k_sem_give(&data->lock);
+
+	return 0;
 }
 
 static int ls013b7dh05_init(const struct device *dev)
 {
 	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
 	int ret;
 
+	data->dev = dev;
+	/* in EXTCOMIN mode, 0 keeps the PWM period from the devicetree */
+	data->vcom_period_ms = config->serial_vcom ? config->vcom_period_ms : 0U;
+	(void)k_sem_init(&data->lock, 1, 1);
+	k_work_init_delayable(&data->vcom_work, ls013b7dh05_vcom_handler);
+
 	if (!spi_is_ready_dt(&config->spi)) {
 		LOG_ERR("SPI not ready");
 		return -ENODEV;
 	}
 
-	if (!pwm_is_ready_dt(&config->extcomin)) {
+	if (!config->serial_vcom && !pwm_is_ready_dt(&config->extcomin)) {
 		LOG_ERR("EXTCOMIN PWM not ready");
 		return -ENODEV;
 	}
@@ -187,7 +786,7 @@ static int ls013b7dh05_init(const struct device *dev)
 		return ret;
 	}
 
-	ret = pwm_set_pulse_dt(&config->extcomin, 0U);
+	ret = ls013b7dh05_vcom_stop(dev);
 	if (ret < 0) {
 		return ret;
 	}
@@ -197,13 +796,260 @@ static int ls013b7dh05_init(const struct device *dev)
 		return ret;
 	}
 
-	for (uint8_t line = 0U; line < (config->height - 1U); line++) {
-		config->fb[line * (config->width / 8U + 2U) + config->width / 8U + 1U] = line + 2U;
+	for (uint8_t line = 0U; line < config->height; line++) {
+		config->hdr[line][0] = 0U;
+		config->hdr[line][1] = line + 1U;
+	}
+
+	ls013b7dh05_invalidate(dev);
+
+	return 0;
+}
+
+int ls013b7dh05_clear(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	struct spi_buf sbuf = {.buf = data->mode, .len = sizeof(data->mode)};
+	struct spi_buf_set sbufs = {.buffers = &sbuf, .count = 1U};
+	int ret;
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	if (data->held) {
+		ret = -EPERM;
+		goto end;
+	}
+
+	data->mode[0] = LS013B7DH05_CLEAR | data->vcom;
+	data->mode[1] = 0U;
+
+	ret = spi_write_dt(&config->spi, &sbufs);
+	if (ret < 0) {
+		ls013b7dh05_invalidate(dev);
+		goto end;
+	}
+
+	/* the panel is now white, keep the framebuffer in sync */
+	memset(config->fb, 0xff, config->fb_size * config->fb_count);
+	data->top = 0U;
+
+	for (uint16_t line = 0U; line < config->height; line++) {
+		atomic_clear_bit(config->dirty, line);
+	}
+
+	data->stats.transactions++;
+	data->stats.bytes_sent += sizeof(data->mode);
+
+end:
+	k_sem_give(&data->lock);
+
+	return ret;
+}
+
+int ls013b7dh05_scroll(const struct device *dev, int lines)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	uint8_t top;
+
+	/* the back buffer is not the previous frame, there is nothing to scroll */
+	if (config->fb_count > 1U) {
+		return -ENOTSUP;
+	}
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	top = (data->top + config->height + lines % config->height) % config->height;
+
+	/* the panel still shows the lines from the previous top */
+	for (uint16_t line = 0U; line < config->height; line++) {
+		const uint8_t *cur = &config->fb[((line + data->top) % config->height) *
+						 config->line_width];
+		const uint8_t *next = &config->fb[((line + top) % config->height) *
+						  config->line_width];
+
+		if (memcmp(cur, next, config->line_width) != 0) {
+			atomic_set_bit(config->dirty, line);
+		}
+	}
+
+	data->top = top;
+
+	k_sem_give(&data->lock);
+
+	return 0;
+}
+
+int ls013b7dh05_set_vcom_period(const struct device *dev, uint16_t period_ms)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret = 0;
+
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	if (config->serial_vcom && period_ms == 0U) {
+		period_ms = config->vcom_period_ms;
+	}
+
+	/* 0 keeps the PWM period from the devicetree in EXTCOMIN mode */
+	if (period_ms != 0U) {
+		period_ms = MAX(period_ms, config->min_vcom_period_ms);
+	}
+
+	if (data->held) {
+		/* applied when leaving hold mode */
+		data->run_vcom_period_ms = period_ms;
+	} else {
+		data->vcom_period_ms = period_ms;
+		if (data->vcom_on && !config->serial_vcom) {
+			ret = ls013b7dh05_extcomin_set(dev);
+		}
+	}
+
+	k_sem_give(&data->lock);
+
+	/* the periodic inversion catches up with the new period */
+	if (config->serial_vcom && data->vcom_on && !data->held) {
+		(void)k_work_reschedule(&data->vcom_work, K_NO_WAIT);
+	}
+
+	return ret;
+}
+
+uint8_t *ls013b7dh05_get_line(const struct device *dev, uint16_t y)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+
+	if (config->fb_count == 1U) {
+		ls013b7dh05_mark(dev, y, 1U);
+	}
+
+	return &config->fb[data->back * config->fb_size +
+			   ((y + data->top) % config->height) * config->line_width];
+}
+
+void ls013b7dh05_get_stats(const struct device *dev, struct ls013b7dh05_stats *stats)
+{
+	struct ls013b7dh05_data *data = dev->data;
+
+	*stats = data->stats;
+}
+
+void ls013b7dh05_reset_stats(const struct device *dev)
+{
+	struct ls013b7dh05_data *data = dev->data;
+
+	memset(&data->stats, 0, sizeof(data->stats));
+}
+
+void ls013b7dh05_invalidate(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+
+	ls013b7dh05_mark(dev, 0U, config->height);
+}
+
+#ifdef CONFIG_PM_DEVICE
+/*
+ * Suspending the display enters hold mode: the image stays visible, VCOM is
+ * inverted at the lowest rate the panel allows, the backlight is turned off
+ * and the SPI bus is suspended. The backlight stays off on resume.
+ */
+static int ls013b7dh05_hold(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	ret = led_off(config->backlight, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->run_vcom_period_ms = data->vcom_period_ms;
+	data->vcom_period_ms = config->hold_vcom_period_ms;
+
+	if (data->vcom_on && !config->serial_vcom) {
+		ret = ls013b7dh05_extcomin_set(dev);
+		if (ret < 0) {
+			goto err_vcom;
+		}
+	}
+
+	ret = pm_device_action_run(config->spi.bus, PM_DEVICE_ACTION_SUSPEND);
+	if (ret < 0 && ret != -EALREADY) {
+		goto err_vcom;
 	}
 
+	data->held = true;
+
 	return 0;
+
+err_vcom:
+	data->vcom_period_ms = data->run_vcom_period_ms;
+	if (data->vcom_on && !config->serial_vcom) {
+		(void)ls013b7dh05_extcomin_set(dev);
+	}
+
+	return ret;
 }
 
+static int ls013b7dh05_release(const struct device *dev)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	ret = pm_device_action_run(config->spi.bus, PM_DEVICE_ACTION_RESUME);
+	if (ret < 0 && ret != -EALREADY) {
+		return ret;
+	}
+
+	data->held = false;
+	data->vcom_period_ms = data->run_vcom_period_ms;
+
+	if (data->vcom_on && !config->serial_vcom) {
+		return ls013b7dh05_extcomin_set(dev);
+	}
+
+	return 0;
+}
+
+static int ls013b7dh05_pm_action(const struct device *dev, enum pm_device_action action)
+{
+	const struct ls013b7dh05_config *config = dev->config;
+	struct ls013b7dh05_data *data = dev->data;
+	int ret;
+
+	/* waits for a transfer in progress */
+	(void)k_sem_take(&data->lock, K_FOREVER);
+
+	switch (action) {
+	case PM_DEVICE_ACTION_SUSPEND:
+		ret = ls013b7dh05_hold(dev);
+		break;
+	case PM_DEVICE_ACTION_RESUME:
+		ret = ls013b7dh05_release(dev);
+		break;
+	default:
+		ret = -ENOTSUP;
+		break;
+	}
+
+	k_sem_give(&data->lock);
+
+	/* the periodic inversion follows the new period */
+	if (ret == 0 && config->serial_vcom && data->vcom_on) {
+		(void)k_work_reschedule(&data->vcom_work, K_NO_WAIT);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_PM_DEVICE */
+
 static const struct display_driver_api ls013b7dh05_api = {
 	.blanking_on = ls013b7dh05_blanking_on,
 	.blanking_off = ls013b7dh05_blanking_off,
@@ -211,29 +1057,45 @@ static const struct display_driver_api ls013b7dh05_api = {
 	.write = ls013b7dh05_write,
 	.set_brightness = ls013b7dh05_set_brightness,
 	.get_capabilities = ls013b7dh05_get_capabilities,
+	.set_orientation = ls013b7dh05_set_orientation,
 };
 
 #define LS013B7DH05_DEFINE(n)                                                                      \
-	static uint8_t fb##n[(DT_INST_PROP(n, width) * DT_INST_PROP(n, height)) / 8U +             \
-			     DT_INST_PROP(n, height) * 2U];                                        \
+	static uint8_t fb##n[1U + DT_INST_PROP(n, double_buffered)]                                \
+			    [DIV_ROUND_UP(DT_INST_PROP(n, width), 8U) * DT_INST_PROP(n, height)];  \
+	static uint8_t hdr##n[DT_INST_PROP(n, height)][2];                                         \
+	static ATOMIC_DEFINE(dirty##n, DT_INST_PROP(n, height));                                   \
+	static struct spi_buf bufs##n[DT_INST_PROP(n, height) * 2U + 2U];                          \
+	static struct ls013b7dh05_data ls013b7dh05_data_##n;                                       \
                                                                                                    \
 	static const struct ls013b7dh05_config ls013b7dh05_config_##n = {                          \
 		.spi = SPI_DT_SPEC_INST_GET(n,                                                     \
 					    SPI_OP_MODE_MASTER | SPI_WORD_SET(8U) |                \
-						    SPI_TRANSFER_LSB | SPI_CS_ACTIVE_HIGH |        \
-						    SPI_HOLD_ON_CS | SPI_LOCK_ON,                  \
+						    SPI_TRANSFER_LSB | SPI_CS_ACTIVE_HIGH,         \
 					    0U),                                                   \
 		.disp = GPIO_DT_SPEC_INST_GET(n, disp_gpios),                                      \
-		.extcomin = PWM_DT_SPEC_INST_GET(n),                                               \
+		.extcomin = PWM_DT_SPEC_INST_GET_OR(n, {}),                                        \
 		.backlight = DEVICE_DT_GET(DT_INST_PHANDLE(n, backlight)),                         \
 		.width = DT_INST_PROP(n, width),                                                   \
 		.height = DT_INST_PROP(n, height),                                                 \
 		.line_width = DIV_ROUND_UP(DT_INST_PROP(n, width), 8U),                            \
-		.fb = fb##n,                                                                       \
-		.fb_size = ARRAY_SIZE(fb##n),                                                      \
+		.serial_vcom = DT_INST_ENUM_IDX(n, vcom_mode) == 1,                                \
+		.vcom_period_ms = MSEC_PER_SEC / DT_INST_PROP(n, vcom_frequency),                  \
+		.min_vcom_period_ms =                                                              \
+			DIV_ROUND_UP(MSEC_PER_SEC, DT_INST_PROP(n, max_vcom_frequency)),           \
+		.hold_vcom_period_ms = MSEC_PER_SEC / DT_INST_PROP(n, hold_vcom_frequency),        \
+		.fb = fb##n[0],                                                                    \
+		.fb_size = ARRAY_SIZE(fb##n[0]),                                                   \
+		.fb_count = ARRAY_SIZE(fb##n),                                                     \
+		.hdr = hdr##n,                                                                     \
+		.dirty = dirty##n,                                                                 \
+		.bufs = bufs##n,                                                                   \
 	};                                                                                         \
                                                                                                    \
-	DEVICE_DT_INST_DEFINE(n, &ls013b7dh05_init, NULL, NULL, &ls013b7dh05_config_##n,           \
-			      POST_KERNEL, CONFIG_DISPLAY_INIT_PRIORITY, &ls013b7dh05_api);
+	PM_DEVICE_DT_INST_DEFINE(n, ls013b7dh05_pm_action);                                        \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(n, &ls013b7dh05_init, PM_DEVICE_DT_INST_GET(n),                      \
+			      &ls013b7dh05_data_##n, &ls013b7dh05_config_##n, POST_KERNEL,         \
+			      CONFIG_DISPLAY_INIT_PRIORITY, &ls013b7dh05_api);
 
 DT_INST_FOREACH_STATUS_OKAY(LS013B7DH05_DEFINE)
@@ -0,0 +1,259 @@
+#define DT_DRV_COMPAT sharp_ls013b7dh05
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include <hwv/drivers/display/emul_ls013b7dh05.h>
+
+#ifdef CONFIG_EMUL_LS013B7DH05_DUMP
+#include "emul_ls013b7dh05_native.h"
+#endif
+
+LOG_MODULE_REGISTER(emul_ls013b7dh05, CONFIG_DISPLAY_LOG_LEVEL);
+
+#define LS013B7DH05_WRITE BIT(0)
+#define LS013B7DH05_VCOM  BIT(1)
+#define LS013B7DH05_CLEAR BIT(2)
+
+/* "P4\n" "WWW HHH\n" */
+#define PBM_HEADER_MAX 16U
+
+enum emul_ls013b7dh05_state {
+	STATE_CMD,
+	STATE_ADDR,
+	STATE_DATA,
+	STATE_DUMMY,
+	STATE_TRAILER,
+	STATE_ERROR,
+};
+
+struct emul_ls013b7dh05_config {
+	uint8_t width;
+	uint8_t height;
+	uint8_t line_width;
+	uint8_t *image;
+};
+
+struct emul_ls013b7dh05_data {
+	enum emul_ls013b7dh05_state state;
+	uint8_t vcom;
+	uint8_t line;
+	uint8_t pos;
+	struct emul_ls013b7dh05_stats stats;
+};
+
+static void emul_ls013b7dh05_byte(const struct emul *target, uint8_t byte)
+{
+	const struct emul_ls013b7dh05_config *config = target->cfg;
+	struct emul_ls013b7dh05_data *data = target->data;
+
+	switch (data->state) {
+	case STATE_CMD:
+		if ((byte & LS013B7DH05_VCOM) != data->vcom) {
+			data->vcom = byte & LS013B7DH05_VCOM;
+			data->stats.vcom_toggles++;
+		}
+
+		if ((byte & LS013B7DH05_CLEAR) != 0U) {
+			memset(config->image, 0xff, config->line_width * config->height);
+			data->stats.clears++;
+		}
+
+		if ((byte & LS013B7DH05_WRITE) != 0U) {
+			data->stats.writes++;
+			data->state = STATE_ADDR;
+		} else {
+			data->state = STATE_TRAILER;
+		}
+		break;
+	case STATE_ADDR:
+		/* the dummy byte trailing the last line ends the write */
+		if (byte == 0U) {
+			data->state = STATE_TRAILER;
+		} else if (byte > config->height) {
+			LOG_ERR("Invalid line address %u", byte);
+			data->state = STATE_ERROR;
+		} else {
+			data->line = byte - 1U;
+			data->pos = 0U;
+			data->state = STATE_DATA;
+		}
+		break;
+	case STATE_DATA:
+		config->image[data->line * config->line_width + data->pos] = byte;
+		data->pos++;
+		if (data->pos == config->line_width) {
+			data->stats.lines++;
+			data->state = STATE_DUMMY;
+		}
+		break;
+	case STATE_DUMMY:
+	case STATE_TRAILER:
+		if (byte != 0U) {
+			LOG_ERR("Unexpected byte 0x%02x after line %u", byte, data->line + 1U);
+			data->state = STATE_ERROR;
+		} else if (data->state == STATE_DUMMY) {
+			data->state = STATE_ADDR;
+		}
+		break;
+	case STATE_ERROR:
+		break;
+	}
+}
+
+#ifdef CONFIG_EMUL_LS013B7DH05_DUMP
+static void emul_ls013b7dh05_dump(const struct emul *target)
+{
+	struct emul_ls013b7dh05_data *data = target->data;
+	/* large enough for any panel size */
+	static uint8_t pbm[PBM_HEADER_MAX + UINT8_MAX * DIV_ROUND_UP(UINT8_MAX, 8U)];
+	char path[128];
+	size_t len;
+
+	len = emul_ls013b7dh05_to_pbm(target, pbm, sizeof(pbm));
+
+	snprintf(path, sizeof(path), "%s/%s-%05u.pbm", CONFIG_EMUL_LS013B7DH05_DUMP_DIR,
+		 target->dev->name, data->stats.writes);
+
+	if (emul_ls013b7dh05_native_write(path, pbm, len) < 0) {
+		LOG_ERR("Failed to write %s", path);
+	}
+}
+#endif /* CONFIG_EMUL_LS013B7DH05_DUMP */
+
+static int emul_ls013b7dh05_io(const struct emul *target, const struct spi_config *config,
+			       const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+	struct emul_ls013b7dh05_data *data = target->data;
+	uint32_t writes = data->stats.writes;
+
+	ARG_UNUSED(rx_bufs);
+
+	if ((config->operation & SPI_TRANSFER_LSB) == 0U ||
+	    (config->operation & SPI_CS_ACTIVE_HIGH) == 0U) {
+		LOG_ERR("The panel needs LSB first transfers and an active high CS");
+		data->stats.errors++;
+		return -EIO;
+	}
+
+	if (tx_bufs == NULL) {
+		return 0;
+	}
+
+	/* chip select frames a command */
+	data->state = STATE_CMD;
+	data->stats.transactions++;
+
+	for (size_t i = 0U; i < tx_bufs->count; i++) {
+		const uint8_t *buf = tx_bufs->buffers[i].buf;
+
+		for (size_t j = 0U; j < tx_bufs->buffers[i].len; j++) {
+			emul_ls013b7dh05_byte(target, buf[j]);
+		}
+
+		data->stats.bytes += tx_bufs->buffers[i].len;
+	}
+
+	if (data->state != STATE_TRAILER) {
+		LOG_ERR("Incomplete or invalid command");
+		data->stats.errors++;
+		return 0;
+	}
+
+#ifdef CONFIG_EMUL_LS013B7DH05_DUMP
+	if (data->stats.writes != writes) {
+		emul_ls013b7dh05_dump(target);
+	}
+#else
+	ARG_UNUSED(writes);
+#endif
+
+	return 0;
+}
+
+void emul_ls013b7dh05_get_stats(const struct emul *target, struct emul_ls013b7dh05_stats *stats)
+{
+	struct emul_ls013b7dh05_data *data = target->data;
+
+	*stats = data->stats;
+}
+
+void emul_ls013b7dh05_reset_stats(const struct emul *target)
+{
+	struct emul_ls013b7dh05_data *data = target->data;
+
+	memset(&data->stats, 0, sizeof(data->stats));
+}
+
+const uint8_t *emul_ls013b7dh05_get_image(const struct emul *target)
+{
+	const struct emul_ls013b7dh05_config *config = target->cfg;
+
+	return config->image;
+}
+
+size_t emul_ls013b7dh05_to_pbm(const struct emul *target, uint8_t *buf, size_t size)
+{
+	const struct emul_ls013b7dh05_config *config = target->cfg;
+	size_t len;
+
+	len = snprintf((char *)buf, size, "P4\n%u %u\n", config->width, config->height);
+	if (len + config->line_width * config->height > size) {
+		return 0U;
+	}
+
+	/* PBM has the leftmost pixel in the most significant bit, and 1 for black */
+	for (size_t i = 0U; i < config->line_width * config->height; i++) {
+		uint8_t byte = config->image[i];
+
+		byte = ((byte & 0x55U) << 1) | ((byte & 0xaaU) >> 1);
+		byte = ((byte & 0x33U) << 2) | ((byte & 0xccU) >> 2);
+		byte = (byte << 4) | (byte >> 4);
+
+		buf[len++] = ~byte;
+	}
+
+	return len;
+}
+
+static int emul_ls013b7dh05_init(const struct emul *target, const struct device *parent)
+{
+	const struct emul_ls013b7dh05_config *config = target->cfg;
+	struct emul_ls013b7dh05_data *data = target->data;
+
+	ARG_UNUSED(parent);
+
+	/* the panel comes up with random contents, start from white */
+	memset(config->image, 0xff, config->line_width * config->height);
+	data->state = STATE_CMD;
+
+	return 0;
+}
+
+static const struct spi_emul_api emul_ls013b7dh05_api = {
+	.io = emul_ls013b7dh05_io,
+};
+
+#define EMUL_LS013B7DH05_DEFINE(n)                                                                 \
+	static uint8_t emul_image##n[DT_INST_PROP(n, height)]                                      \
+				    [DIV_ROUND_UP(DT_INST_PROP(n, width), 8U)];                    \
+	static struct emul_ls013b7dh05_data emul_ls013b7dh05_data_##n;                             \
+                                                                                                   \
+	static const struct emul_ls013b7dh05_config emul_ls013b7dh05_config_##n = {                \
+		.width = DT_INST_PROP(n, width),                                                   \
+		.height = DT_INST_PROP(n, height),                                                 \
+		.line_width = DIV_ROUND_UP(DT_INST_PROP(n, width), 8U),                            \
+		.image = emul_image##n[0],                                                         \
+	};                                                                                         \
+                                                                                                   \
+	EMUL_DT_INST_DEFINE(n, emul_ls013b7dh05_init, &emul_ls013b7dh05_data_##n,                  \
+			    &emul_ls013b7dh05_config_##n, &emul_ls013b7dh05_api, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(EMUL_LS013B7DH05_DEFINE)
@@ -0,0 +1,22 @@
+#include <stdio.h>
+
+#include "emul_ls013b7dh05_native.h"
+
+int emul_ls013b7dh05_native_write(const char *path, const void *data, size_t len)
+{
+	FILE *f;
+	size_t written;
+
+	f = fopen(path, "wb");
+	if (f == NULL) {
+		return -1;
+	}
+
+	written = fwrite(data, 1, len, f);
+
+	if (fclose(f) != 0 || written != len) {
+		return -1;
+	}
+
+	return 0;
+}
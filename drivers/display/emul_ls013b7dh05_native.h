@@ -0,0 +1,12 @@
+#ifndef DRIVERS_DISPLAY_EMUL_LS013B7DH05_NATIVE_H_
+#define DRIVERS_DISPLAY_EMUL_LS013B7DH05_NATIVE_H_
+
+#include <stddef.h>
+
+/*
+ * Host side of the frame dumps, built against the host C library. Returns 0 on
+ * success, -1 on failure.
+ */
+int emul_ls013b7dh05_native_write(const char *path, const void *data, size_t len);
+
+#endif /* DRIVERS_DISPLAY_EMUL_LS013B7DH05_NATIVE_H_ */
@@ -0,0 +1,76 @@
+#ifndef HWV_DRIVERS_DISPLAY_EMUL_LS013B7DH05_H_
+#define HWV_DRIVERS_DISPLAY_EMUL_LS013B7DH05_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+/**
+ * @defgroup drivers_display_emul_ls013b7dh05 Sharp LS013B7DH05 SPI emulator
+ * @ingroup drivers_display_ls013b7dh05
+ *
+ * Parses the memory LCD protocol received on an emulated SPI bus (write and
+ * all clear commands, line addresses, dummy bytes and VCOM bit), and rebuilds
+ * the panel image, so that the display path can be exercised off-target.
+ *
+ * @{
+ */
+
+/** @brief Emulator statistics. */
+struct emul_ls013b7dh05_stats {
+	/** Number of SPI transactions. */
+	uint32_t transactions;
+	/** Number of bytes received. */
+	uint64_t bytes;
+	/** Number of write commands, i.e. frames. */
+	uint32_t writes;
+	/** Number of lines written. */
+	uint32_t lines;
+	/** Number of all clear commands. */
+	uint32_t clears;
+	/** Number of VCOM polarity changes. */
+	uint32_t vcom_toggles;
+	/** Number of transactions violating the protocol. */
+	uint32_t errors;
+};
+
+/**
+ * @brief Obtain emulator statistics.
+ *
+ * @param target Emulator instance.
+ * @param stats Where to store the statistics.
+ */
+void emul_ls013b7dh05_get_stats(const struct emul *target, struct emul_ls013b7dh05_stats *stats);
+
+/**
+ * @brief Reset emulator statistics.
+ *
+ * @param target Emulator instance.
+ */
+void emul_ls013b7dh05_reset_stats(const struct emul *target);
+
+/**
+ * @brief Get the panel image.
+ *
+ * @param target Emulator instance.
+ *
+ * @return Panel image, in the display format (PIXEL_FORMAT_MONO01, leftmost
+ * pixel in the least significant bit), lines being one after the other.
+ */
+const uint8_t *emul_ls013b7dh05_get_image(const struct emul *target);
+
+/**
+ * @brief Encode the panel image as a binary PBM (P4) file.
+ *
+ * @param target Emulator instance.
+ * @param buf Output buffer.
+ * @param size Output buffer size.
+ *
+ * @return Length of the PBM file, or 0 if @p buf is too small.
+ */
+size_t emul_ls013b7dh05_to_pbm(const struct emul *target, uint8_t *buf, size_t size);
+
+/** @} */
+
+#endif /* HWV_DRIVERS_DISPLAY_EMUL_LS013B7DH05_H_ */
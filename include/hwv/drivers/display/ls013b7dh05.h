@@ -0,0 +1,193 @@
+#ifndef HWV_DRIVERS_DISPLAY_LS013B7DH05_H_
+#define HWV_DRIVERS_DISPLAY_LS013B7DH05_H_
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @defgroup drivers_display_ls013b7dh05 Sharp LS013B7DH05 extensions
+ * @ingroup drivers
+ *
+ * The display takes 1 bit per pixel with the leftmost pixel in the least
+ * significant bit (PIXEL_FORMAT_MONO01). Full-width lines are sent straight
+ * from the buffer given to display_write(), which does not need to be the
+ * framebuffer and can live in read-only memory. Narrower rectangles, at any x
+ * offset, are merged into the framebuffer, and the lines they cover are sent
+ * from there.
+ *
+ * Only the lines that changed are sent. Lines written from other buffers are
+ * compared with the framebuffer, which holds the panel contents, and merged
+ * rectangles report the lines they changed. Lines changed in place in the
+ * framebuffer cannot be compared: without double buffering, the lines handed
+ * out by display_get_framebuffer() (all of them) and ls013b7dh05_get_line()
+ * are sent by the next write covering them, so they must be obtained again
+ * after each write before being changed.
+ *
+ * Suspending the device with pm_device_action_run() enters hold mode, which
+ * keeps the image on the panel, unlike display_blanking_on(): VCOM is inverted
+ * at the hold-vcom-frequency rate only, the backlight is turned off and the
+ * SPI bus is suspended. Writes, display_blanking_off() and turning the
+ * backlight on fail with -EPERM until the device is resumed. The backlight
+ * stays off on resume.
+ *
+ * @{
+ */
+
+/**
+ * @brief Write completion callback.
+ *
+ * @param dev Display device instance.
+ * @param result 0 on success, negative errno code on failure.
+ * @param user_data User data given to ls013b7dh05_write_async().
+ */
+typedef void (*ls013b7dh05_callback_t)(const struct device *dev, int result, void *user_data);
+
+/** @brief Transfer statistics. */
+struct ls013b7dh05_stats {
+	/** Number of write requests. */
+	uint32_t flushes;
+	/** Number of SPI transactions (chip-select assertions). */
+	uint32_t transactions;
+	/** Number of lines sent to the panel. */
+	uint32_t lines_sent;
+	/** Number of lines skipped because they did not change. */
+	uint32_t lines_skipped;
+	/** Number of bytes sent to the panel. */
+	uint64_t bytes_sent;
+	/** Number of bytes a full refresh of the requested lines would have sent on top. */
+	uint64_t bytes_saved;
+};
+
+/**
+ * @brief Write to the display without waiting for the transfer to finish.
+ *
+ * Same as display_write(), but returns as soon as the transfer has been
+ * started. The buffer must not be modified until @p cb is called. If another
+ * transfer is in progress, waits for it to finish first.
+ *
+ * @param dev Display device instance.
+ * @param x x coordinate of the upper left corner.
+ * @param y y coordinate of the upper left corner.
+ * @param desc Buffer descriptor.
+ * @param buf Buffer to write.
+ * @param cb Completion callback, called from ISR context (can be NULL). It is
+ * called before returning if there is nothing to send.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOTSUP If asynchronous writes are not enabled.
+ * @retval -errno Other negative errno code on failure.
+ */
+int ls013b7dh05_write_async(const struct device *dev, uint16_t x, uint16_t y,
+			    const struct display_buffer_descriptor *desc, const void *buf,
+			    ls013b7dh05_callback_t cb, void *user_data);
+
+/**
+ * @brief Wait for the current transfer to finish.
+ *
+ * @param dev Display device instance.
+ * @param timeout Waiting period.
+ *
+ * @retval 0 if the last transfer was successful.
+ * @retval -EAGAIN If the transfer did not finish in time.
+ * @retval -errno Other negative errno code if the last transfer failed.
+ */
+int ls013b7dh05_wait(const struct device *dev, k_timeout_t timeout);
+
+/**
+ * @brief Clear the display.
+ *
+ * Uses the "all clear" command, which turns the whole panel white in a single
+ * 2-byte transaction. The framebuffer is cleared too, so that it keeps matching
+ * the panel contents, and scrolling is reset.
+ *
+ * @param dev Display device instance.
+ *
+ * @retval 0 if successful.
+ * @retval -errno Negative errno code on failure.
+ */
+int ls013b7dh05_clear(const struct device *dev);
+
+/**
+ * @brief Scroll the framebuffer contents.
+ *
+ * The framebuffer is used as a ring of lines: scrolling only changes which
+ * line is shown at the top of the panel, no line is moved. Lines scrolled out
+ * at one end come back at the other end, and should be redrawn before the next
+ * write. While scrolled, ls013b7dh05_get_line() must be used to locate lines.
+ * Writes from the framebuffer send the lines of the given area wherever they
+ * are in the ring, so a band can be written from the line of its first row.
+ *
+ * The panel has no hardware scrolling, so the next write still sends all lines
+ * that changed on the panel.
+ *
+ * @param dev Display device instance.
+ * @param lines Number of lines to scroll up by, negative to scroll down.
+ *
+ * @retval 0 if successful.
+ * @retval -ENOTSUP If the display is double buffered.
+ */
+int ls013b7dh05_scroll(const struct device *dev, int lines);
+
+/**
+ * @brief Set the VCOM inversion period.
+ *
+ * VCOM is inverted once per period, by the EXTCOMIN PWM or through the
+ * commands, depending on the VCOM mode. Locking it to a whole number of
+ * refreshes lets frames that are shown in turn see both polarities. Periods
+ * shorter than the max-vcom-frequency property allows are lengthened.
+ *
+ * @param dev Display device instance.
+ * @param period_ms Inversion period in milliseconds, 0 for the default one.
+ *
+ * @retval 0 if successful.
+ * @retval -errno Negative errno code on failure.
+ */
+int ls013b7dh05_set_vcom_period(const struct device *dev, uint16_t period_ms);
+
+/**
+ * @brief Get a framebuffer line.
+ *
+ * Without double buffering, the line is sent by the next write covering it.
+ * With double buffering, the line is in the back buffer, which is only handed
+ * over to the display when written after display_get_framebuffer(): writes
+ * located with this function are compared with the panel contents instead,
+ * so that the back buffer can be updated in place from frame to frame.
+ *
+ * @param dev Display device instance.
+ * @param y Line, as shown on the panel.
+ *
+ * @return Pointer to the line data in the framebuffer.
+ */
+uint8_t *ls013b7dh05_get_line(const struct device *dev, uint16_t y);
+
+/**
+ * @brief Obtain transfer statistics.
+ *
+ * @param dev Display device instance.
+ * @param stats Where to store the statistics.
+ */
+void ls013b7dh05_get_stats(const struct device *dev, struct ls013b7dh05_stats *stats);
+
+/**
+ * @brief Reset transfer statistics.
+ *
+ * @param dev Display device instance.
+ */
+void ls013b7dh05_reset_stats(const struct device *dev);
+
+/**
+ * @brief Invalidate the panel contents.
+ *
+ * The next write sends all requested lines, whether they changed or not.
+ *
+ * @param dev Display device instance.
+ */
+void ls013b7dh05_invalidate(const struct device *dev);
+
+/** @} */
+
+#endif /* HWV_DRIVERS_DISPLAY_LS013B7DH05_H_ */
@@ -0,0 +1,119 @@
+import argparse
+import struct
+
+import serial
+
+from dispstream import HEIGHT, PITCH, WIDTH, read_pbm
+from flashload import load
+
+MAGIC = b"HWVA"
+VERSION = 1
+NAME_LEN = 24
+
+
+def packbits(line):
+    out = bytearray()
+    i = 0
+    while i < len(line):
+        run = 1
+        while i + run < len(line) and run < 128 and line[i + run] == line[i]:
+            run += 1
+        if run > 1:
+            out += bytes([257 - run, line[i]])
+            i += run
+            continue
+
+        start = i
+        while i < len(line) and i - start < 128:
+            if i + 1 < len(line) and line[i + 1] == line[i]:
+                break
+            i += 1
+        i = max(i, start + 1)
+        out += bytes([i - start - 1]) + line[start:i]
+
+    return bytes(out)
+
+
+def encode_frame(lines, prev):
+    out = bytearray()
+    y = 0
+    while y < HEIGHT:
+        changed = lines[y] != prev[y]
+        n = 1
+        while y + n < HEIGHT and n < 128 and (lines[y + n] != prev[y + n]) == changed:
+            n += 1
+        if changed:
+            out.append(0x80 | (n - 1))
+            for line in lines[y:y + n]:
+                out += packbits(line)
+        else:
+            out.append(n - 1)
+        y += n
+
+    return bytes(out)
+
+
+def encode_asset(frames, period):
+    out = bytearray(struct.pack("<HHHH", WIDTH, HEIGHT, len(frames), period))
+    # the first frame is coded as changes to a white frame
+    prev = [b"\xff" * PITCH] * HEIGHT
+    for lines in frames:
+        out += encode_frame(lines, prev)
+        prev = lines
+
+    return bytes(out)
+
+
+def build(assets):
+    table = bytearray(MAGIC + struct.pack("<HH", VERSION, len(assets)))
+    data = bytearray()
+    offset = len(table) + len(assets) * (NAME_LEN + 8)
+
+    for name, blob in assets:
+        encoded = name.encode()
+        if len(encoded) >= NAME_LEN:
+            raise ValueError(f"{name}: name too long")
+        table += encoded.ljust(NAME_LEN, b"\0")
+        table += struct.pack("<II", offset + len(data), len(blob))
+        data += blob
+
+    return bytes(table + data)
+
+
+def program(port, image):
+    with serial.Serial(port, 115200, timeout=3) as ser:
+        for line in load(ser, 0, image):
+            print(f"Device: {line}")
+
+
+def main(args):
+    assets = []
+    for spec in args.asset:
+        name, _, files = spec.partition("=")
+        frames = [read_pbm(path) for path in files.split(",")]
+        blob = encode_asset(frames, args.period)
+        raw = len(frames) * PITCH * HEIGHT
+        print(f"{name}: {len(frames)} frames, {len(blob)} bytes ({100 * len(blob) // raw}% of raw)")
+        assets.append((name, blob))
+
+    image = build(assets)
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(image)
+
+    if args.port:
+        program(args.port, image)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-a", "--asset", action="append", required=True,
+                        help="Asset: NAME=FRAME.pbm[,FRAME.pbm...]")
+    parser.add_argument("-t", "--period", type=int, default=0,
+                        help="Frame period in ms, 0 to play as fast as possible")
+    parser.add_argument("-o", "--output", help="Output image file")
+    parser.add_argument("-p", "--port", help="Serial port, to program the assets partition")
+    args = parser.parse_args()
+
+    main(args)
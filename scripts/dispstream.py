@@ -0,0 +1,105 @@
+import argparse
+import time
+
+import serial
+
+WIDTH = 144
+HEIGHT = 168
+PITCH = WIDTH // 8
+
+
+def read_pbm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    # P4 header: magic, width and height, separated by whitespace or comments
+    fields = []
+    pos = 0
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    pos += 1
+
+    if fields[0] != b"P4" or int(fields[1]) != WIDTH or int(fields[2]) != HEIGHT:
+        raise ValueError(f"{path}: not a {WIDTH}x{HEIGHT} binary PBM")
+
+    pixels = data[pos:pos + PITCH * HEIGHT]
+    if len(pixels) != PITCH * HEIGHT:
+        raise ValueError(f"{path}: truncated")
+
+    # PBM has the leftmost pixel in the MSB and 1 for black, the display the
+    # leftmost pixel in the LSB and 1 for white
+    frame = bytes((~int(f"{b:08b}"[::-1], 2)) & 0xFF for b in pixels)
+
+    return [frame[y * PITCH:(y + 1) * PITCH] for y in range(HEIGHT)]
+
+
+def packet(lines, prev):
+    full = b"F" + b"".join(lines)
+    if prev is None:
+        return full
+
+    changed = [y for y in range(HEIGHT) if lines[y] != prev[y]]
+    delta = b"D" + bytes([len(changed)])
+    delta += b"".join(bytes([y]) + lines[y] for y in changed)
+
+    return delta if len(delta) < len(full) else full
+
+
+def main(port, baudrate, images, loops, delta):
+    frames = [read_pbm(path) for path in images]
+
+    with serial.Serial(port, baudrate, timeout=1) as ser:
+        ser.write(b"hwv display stream\r")
+        while True:
+            line = ser.readline().decode(errors="replace")
+            if not line:
+                raise RuntimeError("No answer from the device")
+            if "Streaming" in line:
+                break
+            if "not initialized" in line or "first" in line:
+                raise RuntimeError(line.strip())
+
+        sent = 0
+        prev = None
+        start = time.monotonic()
+
+        for _ in range(loops):
+            for lines in frames:
+                data = packet(lines, prev if delta else None)
+                ser.write(data)
+                sent += len(data)
+                prev = lines
+
+        ser.write(b"E")
+        ser.flush()
+        elapsed = time.monotonic() - start
+
+        print(f"Host: {loops * len(frames)} frames, {sent} bytes in {elapsed:.2f} s, "
+              f"{loops * len(frames) / elapsed:.2f} fps")
+
+        # device statistics
+        for _ in range(3):
+            line = ser.readline().decode(errors="replace").strip()
+            if line:
+                print(f"Device: {line}")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-p", "--port", required=True, help="Serial port")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200, help="Baud rate")
+    parser.add_argument("-n", "--loops", type=int, default=1, help="Number of loops")
+    parser.add_argument("-d", "--delta", action="store_true",
+                        help="Send changed lines only when smaller than a full frame")
+    parser.add_argument("images", nargs="+", help=f"{WIDTH}x{HEIGHT} binary PBM (P4) files")
+    args = parser.parse_args()
+
+    main(args.port, args.baudrate, args.images, args.loops, args.delta)
@@ -0,0 +1,116 @@
+import argparse
+import struct
+import time
+import zlib
+
+import serial
+
+MAGIC = b"HWVD"
+HEADER = struct.Struct("<HHI")
+CHUNK = 2048
+
+
+def frames(ser):
+    """Yield (seq, addr, data) for each valid frame, until the end frame or a timeout."""
+    window = b""
+    while True:
+        byte = ser.read(1)
+        if not byte:
+            return
+
+        window = (window + byte)[-len(MAGIC):]
+        if window != MAGIC:
+            continue
+        window = b""
+
+        header = ser.read(HEADER.size)
+        if len(header) != HEADER.size:
+            return
+
+        seq, length, addr = HEADER.unpack(header)
+        if length > CHUNK:
+            # not a frame header, look for the next magic
+            continue
+
+        data = ser.read(length + 4)
+        if len(data) != length + 4:
+            return
+
+        (crc,) = struct.unpack("<I", data[length:])
+        if zlib.crc32(header + data[:length]) != crc:
+            continue
+
+        yield seq, addr, data[:length]
+        if length == 0:
+            return
+
+
+def dump(ser, base, addr, length, image):
+    """Read [addr, addr + length) into image, return the ranges that are missing."""
+    ser.reset_input_buffer()
+    ser.write(f"hwv flash dump 0x{addr:x} {length}\r".encode())
+
+    # frame n holds chunk n, sequence numbers do not wrap below 128 MB
+    chunks = set(range((length + CHUNK - 1) // CHUNK))
+    ended = False
+    for seq, faddr, data in frames(ser):
+        if not data:
+            ended = True
+            break
+
+        if faddr != addr + seq * CHUNK:
+            continue
+
+        image[faddr - base:faddr - base + len(data)] = data
+        chunks.discard(seq)
+
+    status = ser.readline().decode(errors="replace").strip() if ended else ""
+    if "Failed" in status or "not initialized" in status:
+        raise RuntimeError(f"Device: {status}")
+    if status:
+        print(f"Device: {status}")
+
+    return [(addr + n * CHUNK, min(CHUNK, addr + length - (addr + n * CHUNK)))
+            for n in sorted(chunks)]
+
+
+def main(port, baudrate, start, length, output, retries):
+    image = bytearray(length)
+
+    with serial.Serial(port, baudrate, timeout=2) as ser:
+        t0 = time.monotonic()
+
+        missing = dump(ser, start, start, length, image)
+
+        for _ in range(retries):
+            if not missing:
+                break
+            todo, missing = missing, []
+            for addr, size in todo:
+                print(f"Retrying 0x{addr:08x}, {size} bytes")
+                missing += dump(ser, start, addr, size, image)
+
+        elapsed = time.monotonic() - t0
+
+    with open(output, "wb") as f:
+        f.write(image)
+
+    print(f"Host: {length} bytes in {elapsed:.2f} s, {length / elapsed:.0f} B/s")
+    if missing:
+        for addr, size in missing:
+            print(f"Missing 0x{addr:08x}, {size} bytes")
+        raise SystemExit(1)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-p", "--port", required=True, help="Serial port")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200, help="Baud rate")
+    parser.add_argument("-o", "--output", required=True, help="Output file")
+    parser.add_argument("-r", "--retries", type=int, default=3,
+                        help="Number of attempts at re-reading corrupted frames")
+    parser.add_argument("address", type=lambda s: int(s, 0), help="Start address")
+    parser.add_argument("length", type=lambda s: int(s, 0), help="Number of bytes")
+    args = parser.parse_args()
+
+    main(args.port, args.baudrate, args.address, args.length, args.output, args.retries)
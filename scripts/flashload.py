@@ -0,0 +1,129 @@
+import argparse
+import struct
+import time
+import zlib
+
+import serial
+
+CHUNK = 1024
+WINDOW = 2
+EBADMSG = 74
+# attempts without progress before giving up
+RETRIES = 10
+# longer than the gap after which the device drops a partial chunk
+GAP = 0.2
+
+
+def chunk(seq, data):
+    header = struct.pack("<HH", seq, len(data))
+    return header + data + struct.pack("<I", zlib.crc32(header + data))
+
+
+def abort(ser, seq):
+    """End the load on the device early, with an empty chunk."""
+    time.sleep(GAP)
+    ser.write(chunk(seq, b""))
+
+
+def load(ser, addr, data):
+    """Program data at addr through "hwv flash load", return the device statistics."""
+    ser.reset_input_buffer()
+    ser.write(f"hwv flash load 0x{addr:x} {len(data)}\r".encode())
+    while True:
+        line = ser.readline().decode(errors="replace")
+        if not line:
+            raise RuntimeError("No answer from the device")
+        if "Loading" in line:
+            break
+        if "Failed" in line or "Invalid" in line or "must" in line or "not init" in line:
+            raise RuntimeError(line.strip())
+
+    chunks = [data[i:i + CHUNK] for i in range(0, len(data), CHUNK)]
+    acked = 0
+    sent = 0
+    retries = 0
+    stalled = 0
+
+    # at most two chunks in flight: one programmed, one received
+    while acked < len(chunks):
+        if stalled > RETRIES:
+            abort(ser, acked)
+            print()
+            raise RuntimeError("No progress from the device, load aborted")
+
+        while sent < len(chunks) and sent < acked + WINDOW:
+            ser.write(chunk(sent, chunks[sent]))
+            sent += 1
+
+        line = ser.readline().decode(errors="replace").split()
+        if not line:
+            # chunk or ACK lost, the device drops the partial chunk and
+            # acknowledges again the ones it programmed already
+            retries += 1
+            stalled += 1
+            sent = acked
+            continue
+
+        if line[0] == "ACK" and int(line[1]) >= acked:
+            acked = int(line[1]) + 1
+            stalled = 0
+            print(f"\r{min(acked * CHUNK, len(data))}/{len(data)} bytes", end="", flush=True)
+        elif line[0] == "NAK" and int(line[2]) == -EBADMSG:
+            retries += 1
+            stalled += 1
+            sent = int(line[1])
+        elif line[0] == "NAK":
+            # ends the load on the device
+            ser.write(b"\0")
+            print()
+            raise RuntimeError(f"Device: {ser.readline().decode(errors='replace').strip()}")
+    print()
+
+    # the empty chunk ends the load, it is sent again if it gets lost
+    for _ in range(RETRIES):
+        ser.write(chunk(len(chunks), b""))
+
+        stats = []
+        while len(stats) < 2:
+            line = ser.readline().decode(errors="replace").strip()
+            if not line or line.startswith("NAK"):
+                break
+            if "Failed" in line:
+                raise RuntimeError(f"Device: {line}")
+            if line.startswith(("Loaded", "Erase")):
+                stats.append(line)
+
+        if len(stats) == 2:
+            break
+    else:
+        raise RuntimeError("No answer from the device")
+
+    if retries:
+        stats.append(f"{retries} host retries")
+
+    return stats
+
+
+def main(port, baudrate, addr, path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    with serial.Serial(port, baudrate, timeout=3) as ser:
+        start = time.monotonic()
+        stats = load(ser, addr, data)
+        elapsed = time.monotonic() - start
+
+    for line in stats:
+        print(f"Device: {line}")
+    print(f"Host: {len(data)} bytes in {elapsed:.2f} s, {len(data) / elapsed:.0f} B/s")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-p", "--port", required=True, help="Serial port")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200, help="Baud rate")
+    parser.add_argument("address", type=lambda s: int(s, 0), help="Start address, page aligned")
+    parser.add_argument("file", help="File to program")
+    args = parser.parse_args()
+
+    main(args.port, args.baudrate, args.address, args.file)
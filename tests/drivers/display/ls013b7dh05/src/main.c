@@ -0,0 +1,307 @@
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <hwv/drivers/display/emul_ls013b7dh05.h>
+#include <hwv/drivers/display/ls013b7dh05.h>
+
+#define LCD_NODE   DT_CHOSEN(zephyr_display)
+#define WIDTH      DT_PROP(LCD_NODE, width)
+#define HEIGHT     DT_PROP(LCD_NODE, height)
+#define LINE_WIDTH DIV_ROUND_UP(WIDTH, 8)
+
+#define VCOM_PERIOD_MS 20U
+#define VCOM_FREQ_MAX  DT_PROP(LCD_NODE, max_vcom_frequency)
+
+static const struct device *const disp = DEVICE_DT_GET(LCD_NODE);
+static const struct emul *const emul = EMUL_DT_GET(LCD_NODE);
+
+static uint8_t frame[HEIGHT][LINE_WIDTH];
+/* panel contents the emulator should end up with */
+static uint8_t expected[HEIGHT][LINE_WIDTH];
+
+static const struct display_buffer_descriptor full_desc = {
+	.buf_size = sizeof(frame),
+	.width = WIDTH,
+	.height = HEIGHT,
+	.pitch = WIDTH,
+};
+
+static void assert_image(void)
+{
+	zassert_mem_equal(emul_ls013b7dh05_get_image(emul), expected, sizeof(expected),
+			  "Panel image differs from the expected one");
+}
+
+ZTEST(ls013b7dh05, test_full_write)
+{
+	struct emul_ls013b7dh05_stats emul_stats;
+	struct ls013b7dh05_stats stats;
+
+	for (uint16_t y = 0U; y < HEIGHT; y++) {
+		memset(frame[y], (y % 2U) ? 0x55 : 0xaa, LINE_WIDTH);
+	}
+	memcpy(expected, frame, sizeof(expected));
+
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 1U);
+	zassert_equal(emul_stats.lines, HEIGHT);
+	zassert_equal(emul_stats.errors, 0U);
+
+	/* nothing changed, nothing is sent */
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.transactions, 1U);
+
+	ls013b7dh05_get_stats(disp, &stats);
+	zassert_equal(stats.flushes, 2U);
+	zassert_equal(stats.lines_sent, HEIGHT);
+	zassert_equal(stats.lines_skipped, HEIGHT);
+}
+
+ZTEST(ls013b7dh05, test_partial_write)
+{
+	static const uint8_t rect[10][4];
+	static const uint8_t narrow[2][1];
+	const struct display_buffer_descriptor rect_desc = {
+		.buf_size = sizeof(rect),
+		.width = 32U,
+		.height = ARRAY_SIZE(rect),
+		.pitch = 32U,
+	};
+	const struct display_buffer_descriptor narrow_desc = {
+		.buf_size = sizeof(narrow),
+		.width = 5U,
+		.height = ARRAY_SIZE(narrow),
+		.pitch = 8U,
+	};
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	/* byte aligned black rectangle */
+	zassert_ok(display_write(disp, 16, 20, &rect_desc, rect));
+	for (uint16_t y = 20U; y < 30U; y++) {
+		memset(&expected[y][2], 0x00, 4U);
+	}
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 1U);
+	zassert_equal(emul_stats.lines, 10U);
+
+	/* pixels 3 to 7, the other pixels of the byte keep their value */
+	zassert_ok(display_write(disp, 3, 100, &narrow_desc, narrow));
+	expected[100][0] &= ~0xf8;
+	expected[101][0] &= ~0xf8;
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 2U);
+	zassert_equal(emul_stats.lines, 12U);
+
+	/* the shadow framebuffer matches the panel */
+	zassert_ok(display_write(disp, 0, 0, &full_desc, expected));
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 2U);
+	zassert_equal(emul_stats.errors, 0U);
+}
+
+ZTEST(ls013b7dh05, test_clear)
+{
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	memset(frame, 0x00, sizeof(frame));
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+
+	zassert_ok(ls013b7dh05_clear(disp));
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.clears, 1U);
+
+	/* the driver knows the panel is white */
+	memset(frame, 0xff, sizeof(frame));
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 1U);
+	zassert_equal(emul_stats.errors, 0U);
+}
+
+ZTEST(ls013b7dh05, test_scroll)
+{
+	const struct display_buffer_descriptor band_desc = {
+		.buf_size = 10U * LINE_WIDTH,
+		.width = WIDTH,
+		.height = 10U,
+		.pitch = WIDTH,
+	};
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	/* panel line 10 is now the first line of the framebuffer */
+	zassert_ok(ls013b7dh05_scroll(disp, -10));
+	zassert_equal_ptr(ls013b7dh05_get_line(disp, 10U), display_get_framebuffer(disp));
+
+	/* band across the end of the ring */
+	for (uint16_t y = 5U; y < 15U; y++) {
+		memset(ls013b7dh05_get_line(disp, y), 0x00, LINE_WIDTH);
+		memset(expected[y], 0x00, LINE_WIDTH);
+	}
+
+	zassert_ok(display_write(disp, 0, 5, &band_desc, ls013b7dh05_get_line(disp, 5U)));
+	assert_image();
+
+	/* band starting at the first line of the framebuffer */
+	for (uint16_t y = 10U; y < 20U; y++) {
+		memset(ls013b7dh05_get_line(disp, y), 0x55, LINE_WIDTH);
+		memset(expected[y], 0x55, LINE_WIDTH);
+	}
+
+	zassert_ok(display_write(disp, 0, 10, &band_desc, ls013b7dh05_get_line(disp, 10U)));
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.writes, 2U);
+	zassert_equal(emul_stats.lines, 20U);
+	zassert_equal(emul_stats.errors, 0U);
+
+	zassert_ok(ls013b7dh05_scroll(disp, 10));
+}
+
+ZTEST(ls013b7dh05, test_scroll_changed)
+{
+	const struct display_buffer_descriptor band_desc = {
+		.buf_size = 9U * LINE_WIDTH,
+		.width = WIDTH,
+		.height = 9U,
+		.pitch = WIDTH,
+	};
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	for (uint16_t y = 40U; y < 48U; y++) {
+		memset(ls013b7dh05_get_line(disp, y), 0x00, LINE_WIDTH);
+	}
+
+	zassert_ok(display_write(disp, 0, 39, &band_desc, ls013b7dh05_get_line(disp, 39U)));
+
+	/* only the lines at the edges of the black band change on the panel */
+	zassert_ok(ls013b7dh05_scroll(disp, 1));
+	emul_ls013b7dh05_reset_stats(emul);
+
+	zassert_ok(display_write(disp, 0, 39, &band_desc, ls013b7dh05_get_line(disp, 39U)));
+
+	for (uint16_t y = 39U; y < 47U; y++) {
+		memset(expected[y], 0x00, LINE_WIDTH);
+	}
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.lines, 2U);
+	zassert_equal(emul_stats.errors, 0U);
+
+	zassert_ok(ls013b7dh05_scroll(disp, -1));
+}
+
+ZTEST(ls013b7dh05, test_vcom)
+{
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	zassert_ok(ls013b7dh05_set_vcom_period(disp, VCOM_PERIOD_MS));
+	zassert_ok(display_blanking_off(disp));
+	emul_ls013b7dh05_reset_stats(emul);
+
+	k_sleep(K_MSEC(10U * VCOM_PERIOD_MS + VCOM_PERIOD_MS / 2U));
+
+	/* a static image only gets "display mode" commands */
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_between_inclusive(emul_stats.vcom_toggles, 8U, 11U);
+	zassert_equal(emul_stats.transactions, emul_stats.vcom_toggles);
+	zassert_equal(emul_stats.writes, 0U);
+	zassert_equal(emul_stats.errors, 0U);
+	assert_image();
+
+	zassert_ok(display_blanking_on(disp));
+	emul_ls013b7dh05_reset_stats(emul);
+
+	k_sleep(K_MSEC(5U * VCOM_PERIOD_MS));
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_equal(emul_stats.vcom_toggles, 0U);
+}
+
+ZTEST(ls013b7dh05, test_vcom_max_frequency)
+{
+	struct emul_ls013b7dh05_stats emul_stats;
+
+	/* lengthened to the shortest period the panel allows */
+	zassert_ok(ls013b7dh05_set_vcom_period(disp, 1U));
+	zassert_ok(display_blanking_off(disp));
+	emul_ls013b7dh05_reset_stats(emul);
+
+	k_sleep(K_MSEC(MSEC_PER_SEC));
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	zassert_true(emul_stats.vcom_toggles <= VCOM_FREQ_MAX);
+	zassert_true(emul_stats.vcom_toggles >= VCOM_FREQ_MAX / 2U);
+}
+
+ZTEST(ls013b7dh05, test_stats)
+{
+	struct emul_ls013b7dh05_stats emul_stats;
+	struct ls013b7dh05_stats stats;
+
+	for (uint16_t y = 0U; y < HEIGHT; y += 2U) {
+		memset(frame[y], 0x00, LINE_WIDTH);
+	}
+	memcpy(expected, frame, sizeof(expected));
+
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+	assert_image();
+
+	emul_ls013b7dh05_get_stats(emul, &emul_stats);
+	ls013b7dh05_get_stats(disp, &stats);
+
+	zassert_equal(stats.flushes, 1U);
+	zassert_equal(stats.transactions, emul_stats.transactions);
+	zassert_equal(stats.lines_sent, HEIGHT / 2U);
+	zassert_equal(stats.lines_sent, emul_stats.lines);
+	zassert_equal(stats.lines_skipped, HEIGHT / 2U);
+	zassert_equal(stats.bytes_sent, emul_stats.bytes);
+	zassert_equal(stats.bytes_saved, HEIGHT / 2U * (LINE_WIDTH + 2U));
+}
+
+static void ls013b7dh05_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* no periodic VCOM inversion unless a test asks for it */
+	zassert_ok(display_blanking_on(disp));
+
+	/* start from a white panel */
+	memset(frame, 0xff, sizeof(frame));
+	memset(expected, 0xff, sizeof(expected));
+	ls013b7dh05_invalidate(disp);
+	zassert_ok(display_write(disp, 0, 0, &full_desc, frame));
+
+	ls013b7dh05_reset_stats(disp);
+	emul_ls013b7dh05_reset_stats(emul);
+}
+
+static void ls013b7dh05_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)ls013b7dh05_set_vcom_period(disp, 0U);
+}
+
+ZTEST_SUITE(ls013b7dh05, NULL, NULL, ls013b7dh05_before, ls013b7dh05_after, NULL);